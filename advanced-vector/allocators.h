@@ -0,0 +1,275 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+//Высокопроизводительные аллокаторы для RawMemory/Vector.
+//Оба аллокатора потокобезопасны за счёт того, что всё их состояние хранится
+//в thread_local-хранилищах: рабочие потоки не конкурируют за общий кеш.
+
+namespace allocators_detail {
+
+    // Линейная (bump) арена: выделение — сдвиг указателя, освобождение — только целиком
+    class ArenaStorage {
+    public:
+        static constexpr size_t kBlockSize = 64 * 1024;
+
+        void* Allocate(size_t bytes, size_t alignment) {
+            size_t shift = (alignment - cursor_ % alignment) % alignment;
+            if (current_ == nullptr || cursor_ + shift + bytes > current_->size) {
+                PushBlock(bytes < kBlockSize ? kBlockSize : bytes);
+                shift = 0;
+            }
+            cursor_ += shift;
+            void* result = current_->data + cursor_;
+            cursor_ += bytes;
+            return result;
+        }
+
+        // Освобождает все блоки арены разом; живых объектов к этому моменту быть не должно
+        void Reset() noexcept {
+            while (current_ != nullptr) {
+                Block* prev = current_->prev;
+                std::free(current_);
+                current_ = prev;
+            }
+            cursor_ = 0;
+        }
+
+        ~ArenaStorage() {
+            Reset();
+        }
+
+    private:
+        struct Block {
+            Block* prev;
+            size_t size;
+            alignas(std::max_align_t) unsigned char data[1];
+        };
+
+        void PushBlock(size_t bytes) {
+            void* raw = std::malloc(offsetof(Block, data) + bytes);
+            if (raw == nullptr) {
+                throw std::bad_alloc();
+            }
+            Block* block = static_cast<Block*>(raw);
+            block->prev = current_;
+            block->size = bytes;
+            current_ = block;
+            cursor_ = 0;
+        }
+
+        Block* current_ = nullptr;
+        size_t cursor_ = 0;
+    };
+
+    inline ArenaStorage& ThreadLocalArena() {
+        static thread_local ArenaStorage arena;
+        return arena;
+    }
+
+    // Пул свободных блоков по классам размеров (степени двойки от 64 байт)
+    class PoolStorage {
+    public:
+        static constexpr size_t kMinClassBytes = 64;
+        static constexpr size_t kClassCount = 32;
+
+        void* Allocate(size_t bytes) {
+            const size_t cls = SizeClass(bytes);
+            if (FreeList*& head = free_lists_[cls]; head != nullptr) {
+                FreeList* node = head;
+                head = node->next;
+                return node;
+            }
+            void* raw = std::malloc(ClassBytes(cls));
+            if (raw == nullptr) {
+                throw std::bad_alloc();
+            }
+            return raw;
+        }
+
+        void Deallocate(void* ptr, size_t bytes) noexcept {
+            FreeList* node = static_cast<FreeList*>(ptr);
+            node->next = free_lists_[SizeClass(bytes)];
+            free_lists_[SizeClass(bytes)] = node;
+        }
+
+        ~PoolStorage() {
+            for (FreeList*& head : free_lists_) {
+                while (head != nullptr) {
+                    FreeList* next = head->next;
+                    std::free(head);
+                    head = next;
+                }
+            }
+        }
+
+    private:
+        struct FreeList {
+            FreeList* next;
+        };
+
+        static size_t SizeClass(size_t bytes) noexcept {
+            size_t cls = 0;
+            while (ClassBytes(cls) < bytes) {
+                ++cls;
+            }
+            assert(cls < kClassCount);
+            return cls;
+        }
+
+        static constexpr size_t ClassBytes(size_t cls) noexcept {
+            return kMinClassBytes << cls;
+        }
+
+        FreeList* free_lists_[kClassCount] = {};
+    };
+
+    inline PoolStorage& ThreadLocalPool() {
+        static thread_local PoolStorage pool;
+        return pool;
+    }
+
+}  // namespace allocators_detail
+
+//Арена-аллокатор для короткоживущих векторов.
+//Allocate — сдвиг указателя в thread_local-арене, Deallocate — пустая операция:
+//память возвращается только целиком через ReleaseAll() в конце запроса.
+template <typename T>
+struct ArenaAllocator {
+    static T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(
+            allocators_detail::ThreadLocalArena().Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    static void Deallocate(T* /*buf*/, size_t /*n*/) noexcept {
+        // индивидуальное освобождение не поддерживается — см. ReleaseAll
+    }
+
+    // Освобождает все блоки арены текущего потока.
+    // Вызывать можно, только когда ни один живой Vector не использует арену.
+    static void ReleaseAll() noexcept {
+        allocators_detail::ThreadLocalArena().Reset();
+    }
+};
+
+//Пул-аллокатор для устоявшейся нагрузки: освобождённые буферы попадают
+//в списки свободных блоков по классам размеров и переиспользуются без
+//обращения к глобальной куче.
+template <typename T>
+struct PoolAllocator {
+    static T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(allocators_detail::ThreadLocalPool().Allocate(n * sizeof(T)));
+    }
+
+    static void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            allocators_detail::ThreadLocalPool().Deallocate(buf, n * sizeof(T));
+        }
+    }
+};
+
+//Аллокатор с гарантированным выравниванием буфера.
+//Обычный operator new даёт лишь __STDC_DEFAULT_NEW_ALIGNMENT__ (16 байт);
+//SIMD-ядра над Vector<float> хотят 64 байта, чтобы обходиться выровненными
+//загрузками без peel-цикла. AlignedAllocator направляет выделение через
+//operator new(size, align_val_t): begin() всегда кратен Align, и это
+//свойство сохраняется при каждом росте — Reserve и реаллоцирующий Emplace
+//берут новую память у того же аллокатора.
+//То же выравнивание по границе кеш-линии убирает false sharing между
+//соседними по куче буферами.
+template <typename T, size_t Align>
+struct AlignedAllocator {
+    static_assert(Align >= alignof(T), "выравнивание не может быть меньше alignof(T)");
+    static_assert((Align & (Align - 1)) == 0, "выравнивание должно быть степенью двойки");
+
+    static T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{ Align }));
+    }
+
+    static void Deallocate(T* buf, size_t /*n*/) noexcept {
+        operator delete(buf, std::align_val_t{ Align });
+    }
+};
+
+//Выравнивание под AVX-512 и под границу кеш-линии x86-64
+template <typename T>
+using SimdAllocator = AlignedAllocator<T, 64>;
+
+template <typename T>
+using CacheLineAllocator = AlignedAllocator<T, 64>;
+
+//Аллокатор с поддержкой больших страниц для многогигабайтных векторов.
+//Буферы от ThresholdBytes и выше берутся напрямую у mmap: сперва явные
+//hugepages (MAP_HUGETLB), при их отсутствии — обычные страницы с подсказкой
+//madvise(MADV_HUGEPAGE) для прозрачного слияния ядром. Меньше TLB-промахов
+//на линейных сканах. Рост вектора промотирует буфер автоматически: Reserve
+//и реаллоцирующий Emplace запрашивают новую память у этого же аллокатора,
+//и как только размер пересекает порог, буфер оказывается на больших страницах.
+//Буферы меньше порога обслуживает NewDeleteAllocator.
+//Вне Linux аллокатор сводится к NewDeleteAllocator целиком.
+template <typename T, size_t ThresholdBytes = (size_t{2} << 20)>
+struct HugePageAllocator {
+    // Размер большой страницы x86-64; mmap-блоки округляются до него
+    static constexpr size_t kHugePageBytes = size_t{2} << 20;
+
+    static T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+#ifdef __linux__
+        const size_t bytes = n * sizeof(T);
+        if (bytes >= ThresholdBytes) {
+            const size_t rounded = RoundToHugePage(bytes);
+            void* raw = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (raw == MAP_FAILED) {
+                // явные hugepages не зарезервированы — берём обычные и просим THP
+                raw = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (raw == MAP_FAILED) {
+                    throw std::bad_alloc();
+                }
+                ::madvise(raw, rounded, MADV_HUGEPAGE);
+            }
+            return static_cast<T*>(raw);
+        }
+#endif
+        return NewDeleteAllocator<T>::Allocate(n);
+    }
+
+    static void Deallocate(T* buf, size_t n) noexcept {
+        if (buf == nullptr) {
+            return;
+        }
+#ifdef __linux__
+        const size_t bytes = n * sizeof(T);
+        if (bytes >= ThresholdBytes) {
+            ::munmap(buf, RoundToHugePage(bytes));
+            return;
+        }
+#endif
+        NewDeleteAllocator<T>::Deallocate(buf, n);
+    }
+
+private:
+    static constexpr size_t RoundToHugePage(size_t bytes) noexcept {
+        return ((bytes + kHugePageBytes - 1) / kHugePageBytes) * kHugePageBytes;
+    }
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include "vector.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+//Отложенная утилизация больших векторов. Синхронное разрушение сотен
+//миллионов элементов в ~Vector останавливает горячий поток на секунды;
+//ReleaseAsync вместо этого передаёт буфер и диапазон элементов фоновому
+//потоку утилизации: вызывающий платит O(1), а цикл деструкторов и
+//освобождение памяти уходят с критического пути. Для тривиально
+//разрушаемых типов поэлементного цикла нет вовсе — в очередь попадает
+//только освобождение буфера.
+//Фоновый поток один на процесс, запускается лениво при первой задаче.
+//DrainAsyncReclaim дожидается опустошения очереди — это точка
+//синхронизации для тестов и упорядоченного завершения.
+
+namespace async_reclaim_detail {
+
+    class ReclaimQueue {
+    public:
+        struct Task {
+            virtual ~Task() = default;
+            virtual void Run() noexcept = 0;
+            Task* next = nullptr;
+        };
+
+        // Синглтон намеренно «протекает»: очередь и её мьютекс обязаны пережить
+        // статическую деинициализацию, пока жив отсоединённый рабочий поток
+        static ReclaimQueue& Instance() {
+            static ReclaimQueue* queue = new ReclaimQueue();
+            return *queue;
+        }
+
+        void Enqueue(Task* task) {
+            {
+                std::lock_guard lock(mutex_);
+                EnsureWorker();
+                task->next = nullptr;
+                if (tail_ != nullptr) {
+                    tail_->next = task;
+                }
+                else {
+                    head_ = task;
+                }
+                tail_ = task;
+                ++pending_;
+            }
+            wake_.notify_one();
+        }
+
+        // Блокирует вызывающего, пока все поставленные задачи не завершатся
+        void Drain() {
+            std::unique_lock lock(mutex_);
+            drained_.wait(lock, [this] {
+                return pending_ == 0;
+            });
+        }
+
+    private:
+        ReclaimQueue() = default;
+
+        void EnsureWorker() {
+            if (!worker_started_) {
+                std::thread([this] {
+                    WorkerLoop();
+                }).detach();
+                worker_started_ = true;
+            }
+        }
+
+        void WorkerLoop() {
+            for (;;) {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [this] {
+                    return head_ != nullptr;
+                });
+                Task* task = head_;
+                head_ = head_->next;
+                if (head_ == nullptr) {
+                    tail_ = nullptr;
+                }
+                lock.unlock();
+                task->Run();
+                delete task;
+                lock.lock();
+                if (--pending_ == 0) {
+                    drained_.notify_all();
+                }
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable drained_;
+        Task* head_ = nullptr;
+        Task* tail_ = nullptr;
+        size_t pending_ = 0;
+        bool worker_started_ = false;
+    };
+
+}  // namespace async_reclaim_detail
+
+//Передаёт содержимое вектора фоновому потоку утилизации; вектор пустеет
+//и сразу пригоден к повторному использованию.
+//Если буфер разделён со снапшотами, снимается только доля владения вектора —
+//это уже O(1), и задача в очередь не ставится.
+//Алгоритмическая сложность: O(1) в вызывающем потоке.
+template <typename T, typename Allocator, typename GrowthPolicy, ExceptionSafety Safety>
+void ReleaseAsync(Vector<T, Allocator, GrowthPolicy, Safety>& v) {
+    struct ReclaimTask final : async_reclaim_detail::ReclaimQueue::Task {
+        ReclaimTask(RawMemory<T, Allocator>&& buffer, size_t count)
+            : buffer(std::move(buffer))
+            , count(count) {
+        }
+
+        void Run() noexcept override {
+            // для тривиально разрушаемых типов цикл компилируется в ничто,
+            // остаётся только освобождение буфера в деструкторе RawMemory
+            vector_detail::DestroyN(buffer.GetAddress(), count);
+        }
+
+        RawMemory<T, Allocator> buffer;
+        size_t count;
+    };
+
+    size_t count = 0;
+    RawMemory<T, Allocator> buffer = v.ReleaseStorage(count);
+    if (buffer.GetAddress() == nullptr) {
+        return;
+    }
+    async_reclaim_detail::ReclaimQueue::Instance().Enqueue(
+        new ReclaimTask(std::move(buffer), count));
+}
+
+//Дожидается завершения всех задач, поставленных через ReleaseAsync.
+inline void DrainAsyncReclaim() {
+    async_reclaim_detail::ReclaimQueue::Instance().Drain();
+}
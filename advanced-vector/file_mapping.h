@@ -0,0 +1,160 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Отображение векторов фиксированных записей на файлы без копирования.
+//FlushToFile сбрасывает буфер вектора на диск одним куском; MappedVector
+//открывает такой файл через mmap: данные не читаются заранее, страницы
+//подгружаются ядром лениво при первом обращении, а несколько процессов
+//делят одну физическую копию в read-only режиме.
+//Формат файла — сырые байты элементов; работает только для тривиально
+//копируемых T, размер файла обязан быть кратен sizeof(T).
+
+namespace file_mapping_detail {
+
+    [[noreturn]] inline void ThrowErrno(const std::string& action, const std::string& path) {
+        throw std::runtime_error(action + " " + path + ": " + std::strerror(errno));
+    }
+
+}  // namespace file_mapping_detail
+
+//Read-only представление файла как последовательности элементов T.
+//Владеет отображением и снимает его в деструкторе; копирование запрещено.
+template <typename T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "MappedVector работает только с тривиально копируемыми типами");
+
+public:
+    using const_iterator = const T*;
+
+    //Открывает файл и отображает его в память целиком.
+    //Алгоритмическая сложность: O(1) — данные не читаются, страницы грузятся лениво.
+    static MappedVector MapFromFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            file_mapping_detail::ThrowErrno("open", path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            file_mapping_detail::ThrowErrno("fstat", path);
+        }
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        if (bytes % sizeof(T) != 0) {
+            ::close(fd);
+            throw std::runtime_error("размер файла " + path + " не кратен размеру элемента");
+        }
+        const T* data = nullptr;
+        if (bytes != 0) {
+            void* mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                file_mapping_detail::ThrowErrno("mmap", path);
+            }
+            data = static_cast<const T*>(mapped);
+        }
+        ::close(fd);  // отображение живёт независимо от дескриптора
+        return MappedVector(data, bytes / sizeof(T), bytes);
+    }
+
+    MappedVector(MappedVector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , mapped_bytes_(std::exchange(other.mapped_bytes_, 0)) {
+    }
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Unmap();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+            mapped_bytes_ = std::exchange(rhs.mapped_bytes_, 0);
+        }
+        return *this;
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    ~MappedVector() {
+        Unmap();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    const T* Data() const noexcept {
+        return data_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    MappedVector(const T* data, size_t size, size_t mapped_bytes) noexcept
+        : data_(data)
+        , size_(size)
+        , mapped_bytes_(mapped_bytes) {
+    }
+
+    void Unmap() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<T*>(data_), mapped_bytes_);
+            data_ = nullptr;
+        }
+    }
+
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t mapped_bytes_ = 0;
+};
+
+//Сбрасывает содержимое вектора в файл одним write.
+//Файл перезаписывается; формат совместим с MappedVector::MapFromFile.
+//Алгоритмическая сложность: O(размер вектора) байтового вывода, без поэлементной сериализации.
+template <typename T, typename Allocator, typename GrowthPolicy, ExceptionSafety Safety>
+void FlushToFile(const Vector<T, Allocator, GrowthPolicy, Safety>& v, const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "FlushToFile работает только с тривиально копируемыми типами");
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        file_mapping_detail::ThrowErrno("open", path);
+    }
+    const char* bytes = reinterpret_cast<const char*>(v.Data());
+    size_t left = v.Size() * sizeof(T);
+    while (left != 0) {
+        const ssize_t written = ::write(fd, bytes, left);
+        if (written < 0) {
+            ::close(fd);
+            file_mapping_detail::ThrowErrno("write", path);
+        }
+        bytes += written;
+        left -= static_cast<size_t>(written);
+    }
+    if (::close(fd) != 0) {
+        file_mapping_detail::ThrowErrno("close", path);
+    }
+}
@@ -1,8 +1,23 @@
-﻿#include "vector.h"
+﻿// Тесты собираются со включённой инструментализацией, чтобы проверять и её
+#define ADVANCED_VECTOR_STATS
+
+#include "vector.h"
+#include "allocators.h"
+#include "async_reclaim.h"
+#include "file_mapping.h"
+#include "small_vector.h"
+#include "segmented_vector.h"
+#include "serialization.h"
+#include "soa_vector.h"
 
 #include <iostream>
 #include <stdexcept>
+#include <cstdio>
+#include <cstring>
 #include <string>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -385,6 +400,1057 @@ void Test5() {
     }
 }
 
+void TestSmallVector() {
+    const int ID = 42;
+    {
+        // пока элементов не больше InlineCapacity, куча не используется
+        SmallVector<int, 4> v;
+        assert(v.IsInline());
+        assert(v.Capacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.IsInline());
+        assert(v.Size() == 4);
+
+        // пятый элемент вытесняет вектор в кучу
+        v.PushBack(4);
+        assert(!v.IsInline());
+        assert(v.Size() == 5);
+        for (int i = 0; i < 5; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, 2> v;
+        v.EmplaceBack(ID);
+        v.EmplaceBack(ID + 1);
+        assert(v.IsInline());
+        assert(Obj::GetAliveObjectCount() == 2);
+
+        SmallVector<Obj, 2> v_moved(std::move(v));
+        assert(v_moved.Size() == 2);
+        assert(v_moved[0].id == ID);
+        assert(v.Size() == 0);
+
+        v_moved.EmplaceBack(ID + 2);
+        assert(!v_moved.IsInline());
+        assert(v_moved[2].id == ID + 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // EmplaceBack существующего элемента должен быть безопасен при вытеснении в кучу
+        SmallVector<TestObj, 1> v(1);
+        assert(v.Size() == v.Capacity());
+        v.EmplaceBack(v[0]);
+        assert(v[0].IsAlive());
+        assert(v[1].IsAlive());
+    }
+}
+
+void TestAllocators() {
+    const size_t SIZE = 1000;
+    {
+        // арена: векторы живут в thread_local-арене, куча не трогается после первого блока
+        Vector<int, ArenaAllocator<int>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+    }
+    ArenaAllocator<int>::ReleaseAll();
+    {
+        Obj::ResetCounters();
+        // пул: освобождённый буфер переиспользуется следующим вектором того же класса размера
+        {
+            Vector<Obj, PoolAllocator<Obj>> v(SIZE / 10);
+            assert(Obj::GetAliveObjectCount() == SIZE / 10);
+        }
+        {
+            Vector<Obj, PoolAllocator<Obj>> v(SIZE / 10);
+            assert(Obj::GetAliveObjectCount() == SIZE / 10);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // большие страницы: буфер промотируется на mmap при пересечении порога
+        Vector<uint64_t, HugePageAllocator<uint64_t, 4096>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i);  // рост пересекает порог в 4 КБ по пути
+        }
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == SIZE - 1);
+        v.PopBack();
+        assert(v.Size() == SIZE - 1);
+    }
+    {
+        // выравнивание: буфер кратен 64 байтам и остаётся таким после каждого роста
+        Vector<float, SimdAllocator<float>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        }
+        assert(v[SIZE - 1] == static_cast<float>(SIZE - 1));
+    }
+}
+
+void TestAppendRange() {
+    const size_t SIZE = 1000;
+    {
+        // пакетная вставка тривиально копируемых элементов: одна реаллокация на весь диапазон
+        int batch[SIZE];
+        for (size_t i = 0; i < SIZE; ++i) {
+            batch[i] = static_cast<int>(i);
+        }
+        Vector<int> v;
+        v.AppendRange(std::begin(batch), std::end(batch));
+        assert(v.Size() == SIZE);
+        assert(v[0] == 0);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+
+        const size_t capacity = v.Capacity();
+        v.Assign(std::begin(batch), std::begin(batch) + SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v.Capacity() == capacity);  // буфер переиспользован
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> src(SIZE / 10);
+        Vector<Obj> v;
+        v.AppendRange(src.begin(), src.end());
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == SIZE / 10 * 2);
+        assert(Obj::num_copied == static_cast<int>(SIZE / 10 * 2));
+
+        v.Assign(src.begin(), src.end());
+        assert(v.Size() == SIZE / 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void TestGrowthPolicy() {
+    const size_t SIZE = 100;
+    {
+        // точный рост: вместимость всегда равна размеру
+        Vector<int, NewDeleteAllocator<int>, ExactGrowth> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+            assert(v.Capacity() == v.Size());
+        }
+    }
+    {
+        // рост 1.5x: после заполнения запас не превышает половины размера
+        Vector<int, NewDeleteAllocator<int>, GoldenGrowth> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Capacity() <= v.Size() + v.Size() / 2);
+    }
+    {
+        // постраничный рост: буфер всегда занимает целое число страниц
+        Vector<int, NewDeleteAllocator<int>, PageQuantizedGrowth<4096>> v;
+        v.ReserveForAtLeast(SIZE);
+        assert(v.Capacity() * sizeof(int) % 4096 == 0);
+        assert(v.Capacity() >= SIZE);
+    }
+    {
+        // подсказка не уменьшает уже выделенную вместимость
+        Vector<int> v;
+        v.Reserve(SIZE);
+        v.ReserveForAtLeast(SIZE / 2);
+        assert(v.Capacity() == SIZE);
+    }
+}
+
+void TestShrinkToFit() {
+    const size_t SIZE = 1000;
+    const int MAGIC = 42;
+    {
+        Vector<int> v;
+        v.Reserve(SIZE);
+        v.PushBack(MAGIC);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 1);
+        assert(v.Size() == 1);
+        assert(v[0] == MAGIC);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE / 10);
+        v.Reserve(SIZE);
+        const int old_move_count = Obj::num_moved;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 10);
+        assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE / 10));
+        assert(Obj::GetAliveObjectCount() == SIZE / 10);
+
+        // просьба не опускает вместимость ниже размера
+        v.ShrinkToCapacity(0);
+        assert(v.Capacity() == SIZE / 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // пустой вектор отдаёт буфер целиком
+        Vector<int> v;
+        v.Reserve(SIZE);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+}
+
+void TestResizeUninitialized() {
+    const size_t SIZE = 1000;
+    {
+        // буфер заполняется извне, как это делает recv/pread
+        Vector<char> v;
+        v.ResizeUninitialized(SIZE);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        std::memset(v.Data(), 'x', v.Size());
+        assert(v[0] == 'x');
+        assert(v[SIZE - 1] == 'x');
+
+        // уменьшение размера не трогает буфер
+        v.ResizeUninitialized(SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v.Capacity() == SIZE);
+    }
+    {
+        const Vector<int> v(SIZE);
+        assert(v.Data() == &v[0]);
+    }
+}
+
+void TestExceptionPolicy() {
+    const int ID = 42;
+    const size_t SIZE = 100;
+    using FastVector = Vector<Obj, NewDeleteAllocator<Obj>, DoublingGrowth, ExceptionSafety::Fast>;
+    {
+        Obj::ResetCounters();
+        FastVector v;
+        v.Reserve(SIZE + 1);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        // вставка в середину без реаллокации: временный объект не создаётся,
+        // поэтому копий нет, а элемент конструируется прямо на месте
+        const int old_copy_count = Obj::num_copied;
+        v.Insert(v.begin() + SIZE / 2, Obj{ ID });
+        assert(v.Size() == SIZE + 1);
+        assert(v[SIZE / 2].id == ID);
+        assert(v[SIZE].id == static_cast<int>(SIZE - 1));
+        assert(Obj::num_copied == old_copy_count);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void TestFileMapping() {
+    const size_t SIZE = 1000;
+    const char* PATH = "mapped_vector_test.bin";
+    {
+        Vector<uint64_t> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i * i);
+        }
+        FlushToFile(v, PATH);
+
+        const auto mapped = MappedVector<uint64_t>::MapFromFile(PATH);
+        assert(mapped.Size() == SIZE);
+        assert(mapped[0] == 0);
+        assert(mapped[SIZE - 1] == (SIZE - 1) * (SIZE - 1));
+
+        // отображение читает те же байты, что были в векторе
+        assert(std::memcmp(mapped.Data(), v.Data(), SIZE * sizeof(uint64_t)) == 0);
+    }
+    std::remove(PATH);
+}
+
+void TestParallelFill() {
+    const size_t THREADS = 4;
+    const size_t PER_THREAD = 10'000;
+    Vector<size_t> v;
+    {
+        auto session = v.StartParallelFill(THREADS * PER_THREAD);
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&session, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    session.Emplace(t * PER_THREAD + i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        session.Commit();
+    }
+    assert(v.Size() == THREADS * PER_THREAD);
+
+    // каждый элемент записан ровно один раз
+    size_t sum = 0;
+    for (size_t i = 0; i < v.Size(); ++i) {
+        sum += v[i];
+    }
+    const size_t n = THREADS * PER_THREAD;
+    assert(sum == n * (n - 1) / 2);
+}
+
+void TestBatchErase() {
+    const size_t SIZE = 100;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        // удаление диапазона из середины одним сдвигом
+        auto it = v.Erase(v.begin() + 10, v.begin() + 20);
+        assert(v.Size() == SIZE - 10);
+        assert(*it == 20);
+        assert(v[9] == 9);
+
+        // удаление по предикату одним проходом
+        const size_t removed = v.EraseIf([](int x) { return x % 2 == 0; });
+        assert(removed == 45);
+        assert(v.Size() == SIZE - 10 - removed);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] % 2 == 1);
+        }
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Erase(v.begin(), v.begin() + SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v[0].id == static_cast<int>(SIZE / 2));
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
+
+        v.EraseIf([](const Obj& obj) { return obj.id >= 75; });
+        assert(v.Size() == SIZE / 4);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 4));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+    // счётчик событий для проверки колбэка трассировки
+    inline std::atomic<int> num_reallocation_events{ 0 };
+
+    void CountReallocations(vector_stats::Event event, size_t /*bytes*/) {
+        if (event == vector_stats::Event::Reallocation) {
+            ++num_reallocation_events;
+        }
+    }
+}  // namespace
+
+void TestInstrumentation() {
+    const size_t SIZE = 1000;
+    auto& stats = vector_stats::Get();
+    stats.Reset();
+    vector_stats::SetCallback(CountReallocations);
+    num_reallocation_events = 0;
+    {
+        Vector<Obj> v;
+        v.Reserve(SIZE);
+        assert(stats.allocations == 1);
+        assert(stats.bytes_allocated == SIZE * sizeof(Obj));
+        assert(stats.reallocation_events == 0);
+
+        v.Resize(SIZE);
+        v.EmplaceBack(42);  // вместимость исчерпана — реаллокация
+        assert(stats.reallocation_events == 1);
+        assert(stats.bytes_relocated == SIZE * sizeof(Obj));
+        assert(num_reallocation_events == 1);
+    }
+    assert(stats.deallocations == stats.allocations);
+    vector_stats::SetCallback(nullptr);
+}
+
+void TestSpanKernels() {
+    const size_t SIZE = 1000;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        // конверсия в span — без копирования, поверх того же буфера
+        std::span<const int> view = v;
+        assert(view.size() == SIZE);
+        assert(view.data() == v.Data());
+        assert(view[10] == 10);
+
+        assert(v.Sum() == static_cast<int>(SIZE * (SIZE - 1) / 2));
+        assert(v.Min() == 0);
+        assert(v.Max() == static_cast<int>(SIZE - 1));
+
+        Vector<int> w;
+        w.CopyFrom(v);
+        assert(w.Equals(v));
+        w[SIZE / 2] = -1;
+        assert(!w.Equals(v));
+        assert(w.Min() == -1);
+
+        v.Fill(7);
+        assert(v.Sum() == static_cast<int>(SIZE) * 7);
+        assert(v.Max() == 7);
+    }
+    {
+        // для double сравнение идёт поэлементно, не через memcmp
+        Vector<double> d(3);
+        d.Fill(1.5);
+        assert(d.Sum() == 4.5);
+        Vector<double> d2;
+        d2.CopyFrom(d);
+        assert(d2.Equals(d));
+    }
+}
+
+void TestInsertBatch() {
+    const size_t SIZE = 100;
+    {
+        // вместимости хватает: вставки применяются на месте
+        Vector<int> v;
+        v.Reserve(SIZE * 2);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i) * 10);
+        }
+        {
+            auto batch = v.StartInsertBatch();
+            batch.Add(5, 41);
+            batch.Add(5, 42);       // равные индексы — в порядке добавления
+            batch.Add(0, 40);
+            batch.Add(SIZE + 100, 43);  // индекс за концом — вставка в конец
+            batch.Commit();
+        }
+        assert(v.Size() == SIZE + 4);
+        assert(v[0] == 40);
+        assert(v[1] == 0);
+        assert(v[6] == 41);
+        assert(v[7] == 42);
+        assert(v[8] == 50);
+        assert(v[SIZE + 3] == 43);
+    }
+    {
+        // вместимости не хватает: слияние в свежий буфер одним проходом
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.ShrinkToFit();
+        {
+            auto batch = v.StartInsertBatch();
+            for (size_t i = 0; i < 10; ++i) {
+                batch.Add(i * 10, 1000 + static_cast<int>(i));
+            }
+            batch.Commit();
+        }
+        assert(v.Size() == SIZE + 10);
+        assert(v[0].id == 1000);
+        assert(v[1].id == 0);
+        assert(v[11].id == 1001);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE + 10));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+
+    // Тип с ресурсом на куче и бросающим перемещением: без трейта реаллокация
+    // шла бы по копирующей ветке, с трейтом — одним memmove
+    struct Relocatable {
+        explicit Relocatable(int id)
+            : ptr(new int(id)) {
+            ++num_constructed;
+        }
+
+        Relocatable(const Relocatable& other)
+            : ptr(new int(*other.ptr)) {
+            ++num_constructed;
+            ++num_copied;
+        }
+
+        Relocatable(Relocatable&& other)  // намеренно без noexcept
+            : ptr(std::exchange(other.ptr, nullptr)) {
+            ++num_constructed;
+            ++num_moved;
+        }
+
+        Relocatable& operator=(const Relocatable& other) {
+            *this = Relocatable(other);
+            return *this;
+        }
+
+        Relocatable& operator=(Relocatable&& other) noexcept {
+            std::swap(ptr, other.ptr);
+            return *this;
+        }
+
+        ~Relocatable() {
+            delete ptr;
+            ++num_destroyed;
+        }
+
+        static void ResetCounters() {
+            num_constructed = 0;
+            num_copied = 0;
+            num_moved = 0;
+            num_destroyed = 0;
+        }
+
+        int* ptr;
+        static inline int num_constructed = 0;
+        static inline int num_copied = 0;
+        static inline int num_moved = 0;
+        static inline int num_destroyed = 0;
+    };
+
+}  // namespace
+
+// объект не хранит указателей на себя — перенос побайтово безопасен
+template <>
+struct IsTriviallyRelocatable<Relocatable> : std::true_type {};
+
+void TestRelocatable() {
+    const size_t SIZE = 1000;
+    static_assert(!std::is_nothrow_move_constructible_v<Relocatable>);
+    static_assert(is_trivially_relocatable_v<Relocatable>);
+    {
+        Relocatable::ResetCounters();
+        Vector<Relocatable> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        // все реаллокации роста прошли без копий, перемещений и деструкторов
+        assert(Relocatable::num_copied == 0);
+        assert(Relocatable::num_moved == 0);
+        assert(Relocatable::num_destroyed == 0);
+        assert(*v[SIZE - 1].ptr == static_cast<int>(SIZE - 1));
+
+        // вставка в середину с реаллокацией — тоже через memmove
+        v.Emplace(v.begin() + SIZE / 2, -1);
+        assert(Relocatable::num_copied == 0);
+        assert(*v[SIZE / 2].ptr == -1);
+        assert(*v[0].ptr == 0);
+        assert(*v[SIZE].ptr == static_cast<int>(SIZE - 1));
+
+        v.ShrinkToFit();
+        assert(Relocatable::num_copied == 0);
+        assert(v.Capacity() == SIZE + 1);
+    }
+    // каждый сконструированный объект разрушен ровно один раз
+    assert(Relocatable::num_destroyed == Relocatable::num_constructed);
+}
+
+void TestSegmentedVector() {
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        SegmentedVector<Obj, 64> v;
+        v.EmplaceBack(0);
+        const Obj* first = &v[0];
+        for (size_t i = 1; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        // рост не переносит элементы: адрес первого элемента стабилен
+        assert(&v[0] == first);
+        assert(v.Size() == SIZE);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE));
+        assert(v.Capacity() % 64 == 0);
+
+        // итератор произвольного доступа
+        int expected = 0;
+        for (const Obj& obj : v) {
+            assert(obj.id == expected);
+            ++expected;
+        }
+        assert((v.begin() + 10)->id == v[10].id);
+        assert((v.end() - v.begin()) == static_cast<ptrdiff_t>(SIZE));
+
+        v.Resize(SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
+        v.ShrinkToFit();
+        assert(v.Capacity() < SIZE);
+
+        SegmentedVector<Obj, 64> copy(v);
+        assert(copy.Size() == v.Size());
+        assert(copy[7].id == 7);
+
+        SegmentedVector<Obj, 64> moved(std::move(v));
+        assert(moved.Size() == SIZE / 2);
+        assert(&moved[0] == first);  // перемещение передаёт чанки без переноса
+        assert(v.Size() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // исключение в конструкторе элемента посреди размерного конструктора:
+        // уже построенные элементы разрушаются, утечки нет (как в Test2)
+        Obj::ResetCounters();
+        Obj::default_construction_throw_countdown = SIZE / 2;
+        try {
+            SegmentedVector<Obj, 64> v(SIZE);
+            assert(false && "ожидалось исключение");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // исключение при копировании элемента в конструкторе копирования
+        Obj::ResetCounters();
+        SegmentedVector<Obj, 64> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v[SIZE / 2].throw_on_copy = true;
+        try {
+            SegmentedVector<Obj, 64> copy(v);
+            assert(false && "ожидалось исключение");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+    // порядок событий аллокатора — чтобы различить политики по пику памяти
+    inline std::vector<vector_stats::Event>* event_log = nullptr;
+
+    void LogEvents(vector_stats::Event event, size_t /*bytes*/) {
+        if (event_log != nullptr) {
+            event_log->push_back(event);
+        }
+    }
+}  // namespace
+
+void TestAssignFrom() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> src(SIZE);
+        Vector<Obj> dst(SIZE / 2);
+
+        // вместимости не хватает: MinimizePeak освобождает буфер до нового выделения
+        std::vector<vector_stats::Event> events;
+        event_log = &events;
+        vector_stats::SetCallback(LogEvents);
+        dst.AssignFrom(src, ReusePolicy::MinimizePeak);
+        vector_stats::SetCallback(nullptr);
+        event_log = nullptr;
+
+        assert(dst.Size() == SIZE);
+        assert(events.size() == 2);
+        assert(events[0] == vector_stats::Event::Deallocate);
+        assert(events[1] == vector_stats::Event::Allocate);
+
+        // вместимости хватает: буфер переиспользуется без обращений к куче
+        Vector<Obj> small(SIZE / 4);
+        dst.AssignFrom(small, ReusePolicy::MinimizePeak);
+        assert(dst.Size() == SIZE / 4);
+        assert(dst.Capacity() == SIZE);
+    }
+    {
+        // PreserveOnThrow: при исключении содержимое не меняется
+        Obj::ResetCounters();
+        Vector<Obj> src(SIZE);
+        src[SIZE - 1].throw_on_copy = true;
+        Vector<Obj> dst(SIZE / 2);
+        try {
+            dst.AssignFrom(src, ReusePolicy::PreserveOnThrow);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+            assert(dst.Size() == SIZE / 2);
+        }
+        // MinimizePeak при том же исключении оставляет вектор пустым
+        try {
+            dst.AssignFrom(src, ReusePolicy::MinimizePeak);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+            assert(dst.Size() == 0);
+        }
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+    // таблица, целиком вычисляемая на этапе компиляции
+    constexpr int ConstexprTableSum(int n) {
+        Vector<int> v;
+        for (int i = 0; i < n; ++i) {
+            v.PushBack(i * i);  // рост через реаллокации
+        }
+        v.Insert(v.begin(), -1);
+        v.Resize(static_cast<size_t>(n));  // усечение с разрушением хвоста
+        Vector<int> copy(v);
+        copy = v;
+        int sum = 0;
+        for (size_t i = 0; i < copy.Size(); ++i) {
+            sum += copy[i];
+        }
+        return sum;
+    }
+}  // namespace
+
+void TestConstexpr() {
+    // вся работа с вектором прошла в constant-evaluated контексте
+    static_assert(ConstexprTableSum(10) == 203);
+    static_assert(ConstexprTableSum(0) == 0);
+    // та же функция работает и в рантайме по обычным путям
+    assert(ConstexprTableSum(10) == 203);
+}
+
+void TestSoaVector() {
+    const size_t SIZE = 1000;
+    Obj::ResetCounters();
+    {
+        SoaVector<uint64_t, double, Obj> records;
+        records.Reserve(SIZE);
+        assert(records.Capacity() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            records.EmplaceBack(i, static_cast<double>(i) * 0.5, static_cast<int>(i));
+        }
+        assert(records.Size() == SIZE);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE));
+
+        // скан по одному полю идёт по плотному массиву
+        uint64_t sum = 0;
+        for (const uint64_t* p = records.FieldBegin<0>(); p != records.FieldEnd<0>(); ++p) {
+            sum += *p;
+        }
+        assert(sum == SIZE * (SIZE - 1) / 2);
+        assert(records.Field<1>(10) == 5.0);
+        assert(records.Field<2>(10).id == 10);
+
+        // рост с реаллокацией всех полей
+        records.EmplaceBack(SIZE, 0.0, Obj{});
+        assert(records.Capacity() == SIZE * 2);
+        assert(records.Field<0>(SIZE) == SIZE);
+        assert(records.Field<2>(0).id == 0);
+
+        records.Resize(SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
+        records.PopBack();
+        assert(records.Size() == SIZE / 2 - 1);
+
+        SoaVector<uint64_t, double, Obj> moved(std::move(records));
+        assert(moved.Size() == SIZE / 2 - 1);
+        assert(records.Size() == 0);
+        assert(moved.Field<2>(7).id == 7);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+
+    // бросивший конструктор поля не течёт: уже созданные поля
+    // недостроенной записи разрушаются при раскрутке
+    Obj::ResetCounters();
+    {
+        SoaVector<Obj, Obj> pairs;
+        pairs.Reserve(4);
+        Obj ok{ 1 };
+        Obj bad{ 2 };
+        bad.throw_on_copy = true;
+        try {
+            pairs.EmplaceBack(ok, bad);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(pairs.Size() == 0);
+        // живы только ok и bad — копия первого поля разрушена при раскрутке
+        assert(Obj::GetAliveObjectCount() == 2);
+
+        // контейнер остаётся пригодным к использованию
+        bad.throw_on_copy = false;
+        pairs.EmplaceBack(ok, bad);
+        assert(pairs.Size() == 1);
+        assert(pairs.Field<0>(0).id == 1);
+        assert(pairs.Field<1>(0).id == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+
+    // бросивший Resize не течёт: целиком построенные хвосты предыдущих
+    // полей разрушаются при раскрутке
+    Obj::ResetCounters();
+    {
+        SoaVector<Obj, Obj> pairs;
+        // хвост первого поля построится полностью, второго — бросит на середине
+        Obj::default_construction_throw_countdown = SIZE + SIZE / 2;
+        try {
+            pairs.Resize(SIZE);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(pairs.Size() == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+
+    // аргументы EmplaceBack могут ссылаться на элементы самого контейнера:
+    // запись конструируется в новых буферах до переноса старых элементов
+    Obj::ResetCounters();
+    {
+        SoaVector<uint64_t, double, Obj> self;
+        self.Reserve(4);
+        for (size_t i = 0; i < 4; ++i) {
+            self.EmplaceBack(i, static_cast<double>(i), static_cast<int>(i));
+        }
+        assert(self.Size() == self.Capacity());
+        // вставка с реаллокацией — ссылки указывают в переносимые буферы
+        self.EmplaceBack(self.Field<0>(0), self.Field<1>(1), self.Field<2>(2));
+        assert(self.Size() == 5);
+        assert(self.Capacity() == 8);
+        assert(self.Field<0>(4) == 0);
+        assert(self.Field<1>(4) == 1.0);
+        assert(self.Field<2>(4).id == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void TestAsyncReclaim() {
+    const size_t SIZE = 10'000;
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v(SIZE);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE));
+
+        // вызывающий поток платит O(1): элементы уходят в фоновую очередь живыми
+        ReleaseAsync(v);
+        assert(v.Size() == 0);
+        assert(v.Capacity() == 0);
+
+        // вектор сразу пригоден к повторному использованию
+        v.PushBack(Obj{ 42 });
+        assert(v[0].id == 42);
+
+        // после Drain все деструкторы гарантированно отработали
+        DrainAsyncReclaim();
+        assert(Obj::GetAliveObjectCount() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+
+    // тривиально разрушаемый тип: в очередь уходит только освобождение буфера
+    Vector<uint64_t> plain;
+    plain.Resize(SIZE);
+    ReleaseAsync(plain);
+    assert(plain.Size() == 0);
+    DrainAsyncReclaim();
+
+    // пустой вектор не ставит задач
+    Vector<uint64_t> empty;
+    ReleaseAsync(empty);
+    DrainAsyncReclaim();
+
+    // при живом снапшоте снимается только доля владения вектора
+    Obj::ResetCounters();
+    {
+        Vector<Obj> shared_v;
+        for (size_t i = 0; i < 10; ++i) {
+            shared_v.EmplaceBack(static_cast<int>(i));
+        }
+        auto snap = shared_v.TakeSnapshot();
+        ReleaseAsync(shared_v);
+        assert(shared_v.Size() == 0);
+        assert(snap.Size() == 10);
+        assert(snap[3].id == 3);
+    }
+    DrainAsyncReclaim();
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void TestPrefetchedScan() {
+    const size_t SIZE = 1'000'000;  // ~8 МБ — достаточно для ветки madvise
+    Vector<uint64_t> v;
+    v.Reserve(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        v.PushBack(i);
+    }
+
+    // скан с предвыборкой обходит все элементы по порядку ровно один раз
+    uint64_t sum = 0;
+    size_t visited = 0;
+    uint64_t expected_next = 0;
+    v.ForEachPrefetched([&](const uint64_t& value) {
+        assert(value == expected_next);
+        ++expected_next;
+        sum += value;
+        ++visited;
+    });
+    assert(visited == SIZE);
+    assert(sum == v.Sum());
+
+    // неконстантная версия может модифицировать элементы
+    v.ForEachPrefetched([](uint64_t& value) {
+        value *= 2;
+    });
+    assert(v[10] == 20);
+    assert(v.Sum() == sum * 2);
+
+    // пустой и короткий векторы проходят по хвостовому циклу
+    Vector<uint64_t> empty;
+    empty.ForEachPrefetched([](const uint64_t&) {
+        assert(false && "Callback on empty vector");
+    });
+    Vector<uint64_t> three;
+    three.PushBack(1);
+    three.PushBack(2);
+    three.PushBack(3);
+    uint64_t small_sum = 0;
+    three.ForEachPrefetched([&](const uint64_t& value) {
+        small_sum += value;
+    });
+    assert(small_sum == 6);
+}
+
+void TestSerialization() {
+    const size_t SIZE = 1000;
+    const char* PATH = "serialized_vector_test.bin";
+    {
+        Vector<uint64_t> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i * 3);
+        }
+        WriteToFile(v, PATH);
+
+        const auto loaded = ReadFromFile<Vector<uint64_t>>(PATH);
+        assert(loaded.Size() == SIZE);
+        assert(loaded.Capacity() == SIZE);  // ровно одно точное выделение
+        assert(std::memcmp(loaded.Data(), v.Data(), SIZE * sizeof(uint64_t)) == 0);
+
+        // пустой вектор — только заголовок
+        Vector<uint64_t> empty;
+        WriteToFile(empty, PATH);
+        const auto loaded_empty = ReadFromFile<Vector<uint64_t>>(PATH);
+        assert(loaded_empty.Size() == 0);
+
+        // несовпадение размера элемента отлавливается по заголовку
+        WriteToFile(v, PATH);
+        try {
+            ReadFromFile<Vector<uint32_t>>(PATH);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        // битому заголовку не верим: count с переполнением count * sizeof(T)
+        // отклоняется до выделения (count лежит по смещению 16)
+        const auto patch_count = [PATH](uint64_t count) {
+            std::FILE* f = std::fopen(PATH, "r+b");
+            assert(f != nullptr);
+            std::fseek(f, 16, SEEK_SET);
+            std::fwrite(&count, sizeof(count), 1, f);
+            std::fclose(f);
+        };
+        patch_count(UINT64_MAX);
+        try {
+            ReadFromFile<Vector<uint64_t>>(PATH);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        // заголовок, обещающий больше данных, чем есть в файле
+        patch_count(SIZE * 2);
+        try {
+            ReadFromFile<Vector<uint64_t>>(PATH);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    std::remove(PATH);
+}
+
+void TestSnapshot() {
+    const size_t SIZE = 100;
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        const int copies_before = Obj::num_copied;
+        const Obj* buf_before = v.Data();
+
+        // снапшот не копирует элементы и видит буфер вектора
+        auto snap = v.TakeSnapshot();
+        assert(Obj::num_copied == copies_before);
+        assert(snap.Size() == SIZE);
+        assert(snap.begin() == buf_before);
+        assert(snap[42].id == 42);
+
+        // повторный снапшот без мутаций переиспользует тот же блок
+        auto snap2 = v.TakeSnapshot();
+        assert(snap2.begin() == snap.begin());
+
+        // первая мутация отвязывает вектор: элементы копируются в свежий буфер,
+        // снапшоты продолжают читать прежний
+        v.EmplaceBack(static_cast<int>(SIZE));
+        assert(Obj::num_copied == copies_before + static_cast<int>(SIZE));
+        assert(v.Data() != buf_before);
+        assert(v.Size() == SIZE + 1);
+        assert(snap.Size() == SIZE);
+        assert(snap.begin() == buf_before);
+        assert(snap[99].id == 99);
+
+        // дальнейшие мутации идут по обычному пути без копирований на отвязку
+        const int copies_after_detach = Obj::num_copied;
+        v.PopBack();
+        v.EmplaceBack(1);
+        assert(Obj::num_copied == copies_after_detach);
+
+        // вектор умирает раньше снапшотов — блок держит элементы живыми
+        Vector<Obj> other;
+        other.EmplaceBack(7);
+        auto last = other.TakeSnapshot();
+        {
+            Vector<Obj> doomed(std::move(other));
+        }
+        assert(last.Size() == 1);
+        assert(last[0].id == 7);
+
+        // Detach() делает точечную запись через operator[] безопасной
+        auto snap3 = v.TakeSnapshot();
+        v.Detach();
+        v[0] = Obj{ -1 };
+        assert(snap3[0].id == 0);
+        assert(v[0].id == -1);
+
+        // позиционные Insert и Erase после снапшота: итератор пересчитывается
+        // на новый буфер, снапшот видит прежнее содержимое
+        const size_t size_before = v.Size();
+        auto snap4 = v.TakeSnapshot();
+        v.Insert(v.begin() + 2, Obj{ 1000 });
+        assert(v.Size() == size_before + 1);
+        assert(v[2].id == 1000);
+        assert(v[3].id == 2);
+        assert(snap4.Size() == size_before);
+        assert(snap4[2].id == 2);
+
+        auto snap5 = v.TakeSnapshot();
+        v.Erase(v.begin() + 2);
+        assert(v.Size() == size_before);
+        assert(v[2].id == 2);
+        assert(snap5[2].id == 1000);
+
+        auto snap6 = v.TakeSnapshot();
+        v.Erase(v.begin() + 1, v.begin() + 3);
+        assert(v.Size() == size_before - 2);
+        assert(v[1].id == 3);
+        assert(snap6.Size() == size_before);
+        assert(snap6[1].id == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
 int main() {
     try {
         Test1();
@@ -392,6 +1458,28 @@ int main() {
         Test3();
         Test4();
         Test5();
+        TestSmallVector();
+        TestAllocators();
+        TestAppendRange();
+        TestGrowthPolicy();
+        TestShrinkToFit();
+        TestResizeUninitialized();
+        TestExceptionPolicy();
+        TestFileMapping();
+        TestParallelFill();
+        TestBatchErase();
+        TestInstrumentation();
+        TestSoaVector();
+        TestConstexpr();
+        TestAssignFrom();
+        TestSegmentedVector();
+        TestRelocatable();
+        TestInsertBatch();
+        TestSpanKernels();
+        TestSnapshot();
+        TestSerialization();
+        TestPrefetchedScan();
+        TestAsyncReclaim();
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,73 @@
+// Тесты параллельного движка массового конструирования и разрушения.
+// Собирается отдельным бинарником, потому что ADVANCED_VECTOR_PARALLEL
+// должен быть определён до включения заголовка:
+//   g++ -std=c++20 -O2 -Wall -pthread -o parallel_main parallel_main.cpp && ./parallel_main
+#define ADVANCED_VECTOR_PARALLEL
+
+#include "vector.h"
+
+#include <atomic>
+
+namespace {
+
+    // Счётчики атомарные: конструкторы и деструкторы работают из нескольких потоков
+    struct Counted {
+        Counted() noexcept {
+            ++num_constructed;
+        }
+
+        Counted(const Counted&) noexcept {
+            ++num_constructed;
+        }
+
+        Counted(Counted&&) noexcept {
+            ++num_constructed;
+        }
+
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&&) = default;
+
+        ~Counted() {
+            ++num_destroyed;
+        }
+
+        static inline std::atomic<uint64_t> num_constructed{ 0 };
+        static inline std::atomic<uint64_t> num_destroyed{ 0 };
+    };
+
+    static_assert(!std::is_trivially_destructible_v<Counted>);
+
+}  // namespace
+
+// Объёмы выше kParallelThreshold уводят конструирование, копирование
+// и разрушение в параллельные ветки; точные счётчики ловят потерянные куски
+void TestParallelBulkOps() {
+    const size_t SIZE = 3'000'000;
+    static_assert(3'000'000 >= vector_detail::kParallelThreshold);
+    {
+        Vector<Counted> v(SIZE);
+        assert(Counted::num_constructed == SIZE);
+        assert(Counted::num_destroyed == 0);
+
+        Vector<Counted> v_copy(v);
+        assert(Counted::num_constructed == 2 * SIZE);
+        assert(Counted::num_destroyed == 0);
+    }
+    assert(Counted::num_destroyed == 2 * SIZE);
+    assert(Counted::num_constructed == Counted::num_destroyed);
+}
+
+// Тривиальный тип проходит те же объёмы по ветке без циклов конструкторов
+void TestParallelTrivial() {
+    Vector<uint64_t> v(3'000'000);
+    assert(v.Size() == 3'000'000);
+    assert(v[0] == 0);
+    assert(v[v.Size() - 1] == 0);
+    v.Resize(4'000'000);
+    assert(v[3'999'999] == 0);
+}
+
+int main() {
+    TestParallelBulkOps();
+    TestParallelTrivial();
+}
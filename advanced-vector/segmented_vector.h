@@ -0,0 +1,296 @@
+#pragma once
+#include "vector.h"
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+//Сегментированное хранилище: элементы лежат в цепочке блоков фиксированного
+//размера, адресуемых через таблицу чанков. PushBack никогда не переносит
+//уже существующие элементы — рост это O(1) выделение одного чанка, адреса
+//и ссылки остаются стабильными на всё время жизни элемента, а транзитный
+//двукратный пик памяти реаллокации исчезает. Цена — лишняя косвенность
+//при доступе по индексу (чанк вычисляется сдвигом и маской).
+//API повторяет Vector: PushBack/EmplaceBack, Reserve, Resize, PopBack,
+//operator[], итераторы с произвольным доступом.
+template <typename T, size_t ChunkCapacity = 1024, typename Allocator = NewDeleteAllocator<T>>
+class SegmentedVector {
+    static_assert(ChunkCapacity != 0 && (ChunkCapacity & (ChunkCapacity - 1)) == 0,
+        "размер чанка должен быть степенью двойки");
+
+public:
+    //Итератор произвольного доступа поверх таблицы чанков
+    template <bool IsConst>
+    class BasicIterator {
+        using ContainerPtr = std::conditional_t<IsConst, const SegmentedVector*, SegmentedVector*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() = default;
+
+        reference operator*() const noexcept {
+            return (*container_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &(*container_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*container_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator result = *this;
+            ++index_;
+            return result;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator result = *this;
+            --index_;
+            return result;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend auto operator<=>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+    private:
+        friend class SegmentedVector;
+
+        BasicIterator(ContainerPtr container, size_t index) noexcept
+            : container_(container)
+            , index_(index) {
+        }
+
+        ContainerPtr container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const size_t size) {
+        try {
+            Resize(size);
+        }
+        catch (...) {
+            // деструктор недостроенного объекта не вызовется, а деструктор
+            // chunks_ освобождает только сырые буферы — элементы чистим сами
+            DestroyRange(0, size_);
+            throw;
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other) {
+        try {
+            Reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) {
+                EmplaceBack(other[i]);
+            }
+        }
+        catch (...) {
+            DestroyRange(0, size_);
+            throw;
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        DestroyRange(0, size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkCapacity;
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        chunks_.Swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+    //Резервирует чанки под capacity элементов. Существующие элементы не переносятся.
+    //Алгоритмическая сложность: O(число добавляемых чанков).
+    void Reserve(size_t capacity) {
+        while (Capacity() < capacity) {
+            chunks_.EmplaceBack(ChunkCapacity);
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size > size_) {
+            Reserve(new_size);
+            // конструируем хвост почанково
+            while (size_ != new_size) {
+                std::construct_at(Slot(size_));
+                ++size_;
+            }
+        }
+        else {
+            DestroyRange(new_size, size_);
+            size_ = new_size;
+        }
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    //Добавляет элемент в конец. Никогда не переносит существующие элементы:
+    //при нехватке места выделяется ровно один новый чанк.
+    //Алгоритмическая сложность: O(1).
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            chunks_.EmplaceBack(ChunkCapacity);
+        }
+        T* slot = Slot(size_);
+        std::construct_at(slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        std::destroy_at(Slot(size_));
+    }
+
+    //Возвращает куче чанки за пределами текущего размера.
+    void ShrinkToFit() {
+        const size_t needed = (size_ + ChunkCapacity - 1) / ChunkCapacity;
+        while (chunks_.Size() > needed) {
+            chunks_.PopBack();
+        }
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    static constexpr size_t kIndexMask = ChunkCapacity - 1;
+    static constexpr size_t kChunkShift = std::countr_zero(ChunkCapacity);
+
+    T* Slot(size_t index) noexcept {
+        return chunks_[index >> kChunkShift].GetAddress() + (index & kIndexMask);
+    }
+
+    void DestroyRange(size_t first, size_t last) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = first; i != last; ++i) {
+                std::destroy_at(Slot(i));
+            }
+        }
+    }
+
+    Vector<RawMemory<T, Allocator>> chunks_;
+    size_t size_ = 0;
+};
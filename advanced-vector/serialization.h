@@ -0,0 +1,174 @@
+#pragma once
+#include "file_mapping.h"
+#include "vector.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+//Нативный бинарный формат сериализации Vector: заголовок с магией, версией,
+//размером элемента и числом элементов, затем сырые байты буфера.
+//WriteTo выводит заголовок и данные одним writev — один системный вызов
+//на вектор вместо поэлементной записи. ReadFrom делает ровно одно выделение
+//точного размера (ResizeUninitialized) и читает байты прямо в буфер вектора,
+//минуя PushBack и промежуточные реаллокации.
+//Как и FlushToFile/MappedVector, формат работает только для тривиально
+//копируемых T; формат зависит от платформы (порядок байтов, размер элемента).
+
+namespace serialization_detail {
+
+    // "AVEC" в little-endian
+    inline constexpr uint32_t kMagic = 0x43455641;
+    inline constexpr uint32_t kVersion = 1;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t elem_size;
+        uint64_t count;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 24);
+
+    // Дописывает iovec-ы до конца, переживая частичные записи
+    inline void WriteVectored(int fd, iovec* iov, int count) {
+        while (count > 0) {
+            const ssize_t written = ::writev(fd, iov, count);
+            if (written < 0) {
+                file_mapping_detail::ThrowErrno("writev", "fd");
+            }
+            size_t left = static_cast<size_t>(written);
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    inline void ReadExact(int fd, void* dst, size_t bytes) {
+        char* cursor = static_cast<char*>(dst);
+        while (bytes != 0) {
+            const ssize_t got = ::read(fd, cursor, bytes);
+            if (got < 0) {
+                file_mapping_detail::ThrowErrno("read", "fd");
+            }
+            if (got == 0) {
+                throw std::runtime_error("неожиданный конец потока при чтении вектора");
+            }
+            cursor += got;
+            bytes -= static_cast<size_t>(got);
+        }
+    }
+
+}  // namespace serialization_detail
+
+//Записывает вектор в дескриптор: заголовок и сырые байты элементов
+//уходят одним writev.
+//Алгоритмическая сложность: O(размер вектора) байтового вывода, один системный вызов.
+template <typename T, typename Allocator, typename GrowthPolicy, ExceptionSafety Safety>
+void WriteTo(const Vector<T, Allocator, GrowthPolicy, Safety>& v, int fd) {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "WriteTo работает только с тривиально копируемыми типами");
+    serialization_detail::Header header{
+        serialization_detail::kMagic, serialization_detail::kVersion, sizeof(T), v.Size() };
+    const size_t payload_bytes = v.Size() * sizeof(T);
+    iovec iov[2] = {
+        { &header, sizeof(header) },
+        { const_cast<T*>(v.Data()), payload_bytes },
+    };
+    serialization_detail::WriteVectored(fd, iov, payload_bytes != 0 ? 2 : 1);
+}
+
+//Читает вектор, записанный WriteTo: одно точное выделение и чтение
+//сырых байтов прямо в буфер без поэлементного конструирования.
+//Заголовку не доверяем: битый или враждебный count отклоняется до выделения,
+//а payload_limit_bytes (если известен — например, размер файла) отсекает
+//заголовки, обещающие больше данных, чем есть в источнике.
+//Алгоритмическая сложность: O(размер вектора) байтового ввода, одно выделение.
+template <typename VectorT>
+VectorT ReadFrom(int fd, uint64_t payload_limit_bytes = UINT64_MAX) {
+    using T = typename VectorT::value_type;
+    static_assert(std::is_trivially_copyable_v<T>,
+        "ReadFrom работает только с тривиально копируемыми типами");
+    serialization_detail::Header header{};
+    serialization_detail::ReadExact(fd, &header, sizeof(header));
+    if (header.magic != serialization_detail::kMagic) {
+        throw std::runtime_error("неверная магия заголовка вектора");
+    }
+    if (header.version != serialization_detail::kVersion) {
+        throw std::runtime_error("неподдерживаемая версия формата вектора");
+    }
+    if (header.elem_size != sizeof(T)) {
+        throw std::runtime_error("размер элемента в заголовке не совпадает с sizeof(T)");
+    }
+    // защита от переполнения count * sizeof(T) и от сужения на 32-битных платформах
+    if (header.count > SIZE_MAX / sizeof(T)) {
+        throw std::runtime_error("число элементов в заголовке вектора не помещается в size_t");
+    }
+    if (header.count * sizeof(T) > payload_limit_bytes) {
+        throw std::runtime_error("заголовок вектора обещает больше данных, чем есть в источнике");
+    }
+    VectorT result;
+    result.ResizeUninitialized(static_cast<size_t>(header.count));
+    serialization_detail::ReadExact(fd, result.Data(), result.Size() * sizeof(T));
+    return result;
+}
+
+//Удобная обёртка: сериализует вектор в файл, перезаписывая его.
+template <typename T, typename Allocator, typename GrowthPolicy, ExceptionSafety Safety>
+void WriteToFile(const Vector<T, Allocator, GrowthPolicy, Safety>& v, const std::string& path) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        file_mapping_detail::ThrowErrno("open", path);
+    }
+    try {
+        WriteTo(v, fd);
+    }
+    catch (...) {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0) {
+        file_mapping_detail::ThrowErrno("close", path);
+    }
+}
+
+//Удобная обёртка: читает вектор из файла, записанного WriteToFile.
+template <typename VectorT>
+VectorT ReadFromFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        file_mapping_detail::ThrowErrno("open", path);
+    }
+    try {
+        // размер файла ограничивает данные, которые заголовок вправе обещать
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            file_mapping_detail::ThrowErrno("fstat", path);
+        }
+        const uint64_t file_bytes = static_cast<uint64_t>(st.st_size);
+        const uint64_t payload_limit =
+            file_bytes > sizeof(serialization_detail::Header)
+                ? file_bytes - sizeof(serialization_detail::Header)
+                : 0;
+        VectorT result = ReadFrom<VectorT>(fd, payload_limit);
+        ::close(fd);
+        return result;
+    }
+    catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
@@ -0,0 +1,226 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//Вектор с оптимизацией малого буфера (small-buffer optimization).
+//Первые InlineCapacity элементов хранятся внутри самого объекта без обращения к куче.
+//При превышении встроенной вместимости элементы переезжают в кучу через RawMemory,
+//дальше контейнер ведёт себя как обычный Vector.
+template <typename T, size_t InlineCapacity = 8>
+class SmallVector {
+    static_assert(InlineCapacity > 0, "InlineCapacity должна быть больше нуля");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+    const_iterator end() const noexcept {
+        return Data() + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    //Конструктор по умолчанию.
+    //Не выделяет память в куче: вместимость равна InlineCapacity.
+    //Алгоритмическая сложность: O(1).
+    SmallVector() noexcept = default;
+
+    //Конструктор, который создаёт вектор заданного размера.
+    //Куча используется, только если size превышает InlineCapacity.
+    //Алгоритмическая сложность: O(размер вектора).
+    explicit SmallVector(const size_t size) {
+        Reserve(size);
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> || std::is_trivially_copyable_v<T>) {
+        MoveFrom(std::move(other));
+    }
+
+    SmallVector& operator=(const SmallVector& rhs) {
+        if (this != &rhs) {
+            SmallVector rhs_copy(rhs);
+            DestroyAll();
+            MoveFrom(std::move(rhs_copy));
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<T> || std::is_trivially_copyable_v<T>) {
+        if (this != &rhs) {
+            DestroyAll();
+            MoveFrom(std::move(rhs));
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        DestroyAll();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsInline() ? InlineCapacity : heap_.Capacity();
+    }
+
+    //Возвращает true, пока элементы лежат во встроенном буфере.
+    bool IsInline() const noexcept {
+        return heap_.Capacity() == 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    //Резервирует достаточно места, чтобы вместить количество элементов, равное capacity.
+    //Если capacity не превышает текущую вместимость, метод не делает ничего;
+    //обратно из кучи во встроенный буфер элементы не возвращаются.
+    //Алгоритмическая сложность: O(размер вектора).
+    void Reserve(size_t capacity) {
+        if (capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T> new_data(capacity);
+        RelocateInto(new_data.GetAddress());
+        heap_.Swap(new_data);
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size > size_) {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+        }
+        else {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy_n(Data() + new_size, size_ - new_size);
+            }
+        }
+        size_ = new_size;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            // рост по той же схеме, что и в Vector: удвоение вместимости
+            RawMemory<T> new_data(size_ * 2);
+            // сначала конструируем новый элемент: args могут ссылаться на элемент этого же вектора
+            new (new_data.GetAddress() + size_) T(std::forward<Args>(args)...);
+            try {
+                RelocateInto(new_data.GetAddress());
+            }
+            catch (...) {
+                std::destroy_at(new_data.GetAddress() + size_);
+                throw;
+            }
+            heap_.Swap(new_data);
+        }
+        else {
+            new (Data() + size_) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        return Data()[size_ - 1];
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(Data() + size_ - 1);
+        --size_;
+    }
+
+private:
+    T* Data() noexcept {
+        return IsInline() ? reinterpret_cast<T*>(inline_buf_) : heap_.GetAddress();
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    // Переносит size_ элементов из текущего хранилища в dst и разрушает исходники
+    void RelocateInto(T* dst) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size_ != 0) {
+                std::memcpy(dst, Data(), size_ * sizeof(T));
+            }
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(Data(), size_, dst);
+            std::destroy_n(Data(), size_);
+        }
+        else {
+            std::uninitialized_copy_n(Data(), size_, dst);
+            std::destroy_n(Data(), size_);
+        }
+    }
+
+    // Забирает содержимое other в пустой вектор:
+    // буфер кучи крадётся, встроенный буфер переносится поэлементно
+    void MoveFrom(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> || std::is_trivially_copyable_v<T>) {
+        assert(size_ == 0 && IsInline());
+        if (other.IsInline()) {
+            other.RelocateInto(reinterpret_cast<T*>(inline_buf_));
+        }
+        else {
+            heap_.Swap(other.heap_);
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    void DestroyAll() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::destroy_n(Data(), size_);
+        }
+        size_ = 0;
+        RawMemory<T> released;
+        heap_.Swap(released);
+    }
+
+    alignas(T) unsigned char inline_buf_[InlineCapacity * sizeof(T)];
+    RawMemory<T> heap_;
+    size_t size_ = 0;
+};
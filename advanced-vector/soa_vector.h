@@ -0,0 +1,281 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//Контейнер structure-of-arrays: каждое поле записи хранится в собственном
+//непрерывном буфере RawMemory. Скан по одному полю читает плотный массив
+//без «чужих» байтов соседних полей, поэтому идёт на полной пропускной
+//способности памяти и хорошо автовекторизуется.
+//API повторяет Vector: PushBack/EmplaceBack, Reserve, Resize, PopBack;
+//доступ к полям — через FieldBegin<I>()/FieldEnd<I>()/Field<I>(index).
+//Строгая гарантия безопасности исключений действует, когда конструкторы
+//полей не бросают (тривиальные и nothrow-move типы); для остальных полей
+//гарантия базовая.
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector требует хотя бы одно поле");
+
+public:
+    //Тип поля с индексом I
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    SoaVector() = default;
+
+    explicit SoaVector(const size_t size) {
+        Resize(size);
+    }
+
+    SoaVector(const SoaVector&) = delete;
+    SoaVector& operator=(const SoaVector&) = delete;
+
+    SoaVector(SoaVector&& other) noexcept {
+        Swap(other);
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~SoaVector() {
+        DestroyAll(std::index_sequence_for<Fields...>{});
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    void Swap(SoaVector& other) noexcept {
+        SwapBuffers(other, std::index_sequence_for<Fields...>{});
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    //Резервирует место под capacity записей во всех полях сразу.
+    //Алгоритмическая сложность: O(размер вектора * число полей).
+    void Reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            RelocateAll(capacity, std::index_sequence_for<Fields...>{});
+            capacity_ = capacity;
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size > size_) {
+            Reserve(new_size);
+            ConstructTail(new_size, std::index_sequence_for<Fields...>{});
+        }
+        else {
+            DestroyTail(new_size, std::index_sequence_for<Fields...>{});
+        }
+        size_ = new_size;
+    }
+
+    //Добавляет запись, конструируя каждое поле из соответствующего аргумента.
+    void PushBack(Fields... values) {
+        EmplaceBack(std::move(values)...);
+    }
+
+    //Аргументы могут ссылаться на элементы самого контейнера: при росте
+    //запись конструируется в новых буферах до переноса старых элементов,
+    //как это делают Vector и SmallVector.
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields),
+            "EmplaceBack требует по одному аргументу на каждое поле");
+        if (size_ == capacity_) {
+            EmplaceBackWithReallocation(std::index_sequence_for<Fields...>{},
+                std::forward<Args>(args)...);
+        }
+        else {
+            ConstructRecord(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+            ++size_;
+        }
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        DestroyRecord(size_, std::index_sequence_for<Fields...>{});
+    }
+
+    //Начало плотного массива поля I — для сканов и SIMD-ядер
+    template <size_t I>
+    FieldType<I>* FieldBegin() noexcept {
+        return std::get<I>(buffers_).GetAddress();
+    }
+
+    template <size_t I>
+    const FieldType<I>* FieldBegin() const noexcept {
+        return std::get<I>(buffers_).GetAddress();
+    }
+
+    template <size_t I>
+    FieldType<I>* FieldEnd() noexcept {
+        return FieldBegin<I>() + size_;
+    }
+
+    template <size_t I>
+    const FieldType<I>* FieldEnd() const noexcept {
+        return FieldBegin<I>() + size_;
+    }
+
+    //Поле I записи с индексом index
+    template <size_t I>
+    FieldType<I>& Field(size_t index) noexcept {
+        assert(index < size_);
+        return FieldBegin<I>()[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Field(size_t index) const noexcept {
+        assert(index < size_);
+        return FieldBegin<I>()[index];
+    }
+
+private:
+    // Переносит элементы одного поля в уже выделенный буфер
+    // той же схемой, что Vector::Reserve
+    template <size_t I>
+    void RelocateFieldInto(RawMemory<FieldType<I>>& new_data) {
+        using F = FieldType<I>;
+        F* src = std::get<I>(buffers_).GetAddress();
+        if constexpr (std::is_trivially_copyable_v<F>) {
+            if (size_ != 0) {
+                std::memcpy(new_data.GetAddress(), src, size_ * sizeof(F));
+            }
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<F> || !std::is_copy_constructible_v<F>) {
+            std::uninitialized_move_n(src, size_, new_data.GetAddress());
+            std::destroy_n(src, size_);
+        }
+        else {
+            std::uninitialized_copy_n(src, size_, new_data.GetAddress());
+            std::destroy_n(src, size_);
+        }
+    }
+
+    template <size_t I>
+    void RelocateField(size_t capacity) {
+        RawMemory<FieldType<I>> new_data(capacity);
+        RelocateFieldInto<I>(new_data);
+        std::get<I>(buffers_).Swap(new_data);
+    }
+
+    // Рост при вставке: запись конструируется в новых буферах до переноса
+    // старых элементов, поэтому аргументы, ссылающиеся на элементы самого
+    // контейнера, остаются валидными всю вставку
+    template <size_t... Is, typename... Args>
+    void EmplaceBackWithReallocation(std::index_sequence<Is...>, Args&&... args) {
+        const size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+        std::tuple<RawMemory<Fields>...> new_buffers{ RawMemory<Fields>(new_capacity)... };
+        size_t constructed = 0;
+        try {
+            ((new (std::get<Is>(new_buffers).GetAddress() + size_)
+                  FieldType<Is>(std::forward<Args>(args)), ++constructed), ...);
+        }
+        catch (...) {
+            ((Is < constructed
+                ? std::destroy_at(std::get<Is>(new_buffers).GetAddress() + size_)
+                : void()), ...);
+            throw;
+        }
+        size_t relocated = 0;
+        try {
+            ((RelocateFieldInto<Is>(std::get<Is>(new_buffers)),
+                std::get<Is>(buffers_).Swap(std::get<Is>(new_buffers)), ++relocated), ...);
+        }
+        catch (...) {
+            // перенос очередного поля бросил: элементы новой записи
+            // разрушаются там, где они сейчас лежат — в уже подменённых
+            // буферах контейнера либо во временных
+            ((Is < relocated
+                ? std::destroy_at(FieldBegin<Is>() + size_)
+                : std::destroy_at(std::get<Is>(new_buffers).GetAddress() + size_)), ...);
+            throw;
+        }
+        capacity_ = new_capacity;
+        ++size_;
+    }
+
+    template <size_t... Is>
+    void RelocateAll(size_t capacity, std::index_sequence<Is...>) {
+        (RelocateField<Is>(capacity), ...);
+    }
+
+    template <size_t... Is>
+    void SwapBuffers(SoaVector& other, std::index_sequence<Is...>) noexcept {
+        (std::get<Is>(buffers_).Swap(std::get<Is>(other.buffers_)), ...);
+    }
+
+    template <size_t... Is, typename... Args>
+    void ConstructRecord(std::index_sequence<Is...>, Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((new (FieldBegin<Is>() + size_) FieldType<Is>(std::forward<Args>(args)), ++constructed), ...);
+        }
+        catch (...) {
+            // конструктор очередного поля бросил: уже созданные поля
+            // недостроенной записи разрушаются, иначе они утекут —
+            // size_ не увеличен, и деструктор контейнера их не увидит
+            DestroyRecordPrefix(size_, constructed, std::index_sequence<Is...>{});
+            throw;
+        }
+    }
+
+    template <size_t... Is>
+    void DestroyRecordPrefix(size_t index, size_t constructed, std::index_sequence<Is...>) noexcept {
+        ((Is < constructed ? std::destroy_at(FieldBegin<Is>() + index) : void()), ...);
+    }
+
+    template <size_t... Is>
+    void DestroyRecord(size_t index, std::index_sequence<Is...>) noexcept {
+        (std::destroy_at(FieldBegin<Is>() + index), ...);
+    }
+
+    template <size_t... Is>
+    void ConstructTail(size_t new_size, std::index_sequence<Is...>) {
+        size_t constructed = 0;
+        try {
+            ((std::uninitialized_value_construct_n(FieldBegin<Is>() + size_, new_size - size_),
+                ++constructed), ...);
+        }
+        catch (...) {
+            // хвост очередного поля бросил (свою недостроенную часть он
+            // уже убрал сам): разрушаем целиком построенные хвосты
+            // предыдущих полей — size_ не увеличен, и деструктор
+            // контейнера их не увидит
+            ((Is < constructed
+                ? (void)std::destroy_n(FieldBegin<Is>() + size_, new_size - size_)
+                : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... Is>
+    void DestroyTail(size_t new_size, std::index_sequence<Is...>) noexcept {
+        (std::destroy_n(FieldBegin<Is>() + new_size, size_ - new_size), ...);
+    }
+
+    template <size_t... Is>
+    void DestroyAll(std::index_sequence<Is...>) noexcept {
+        (std::destroy_n(FieldBegin<Is>(), size_), ...);
+    }
+
+    std::tuple<RawMemory<Fields>...> buffers_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
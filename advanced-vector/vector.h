@@ -1,99 +1,543 @@
 ﻿#pragma once
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <new>
+#include <type_traits>
 #include <utility>
 #include <stdexcept>
 #include <memory>
 #include <algorithm>
+#include <span>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Запрет инлайнинга холодных путей (реаллокация), чтобы не раздувать горячий код
+#if defined(_MSC_VER)
+#define ADVANCED_VECTOR_NOINLINE __declspec(noinline)
+#else
+#define ADVANCED_VECTOR_NOINLINE __attribute__((noinline))
+#endif
+
+//Опциональная инструментализация аллокаций и реаллокаций.
+//Включается определением ADVANCED_VECTOR_STATS перед включением заголовка;
+//без макроса все хуки — пустые inline-функции, и накладных расходов нет вовсе.
+//Счётчики атомарные и общие на процесс; колбэк позволяет завести события
+//во внешнюю систему трассировки.
+namespace vector_stats {
+
+#ifdef ADVANCED_VECTOR_STATS
+    enum class Event {
+        Allocate,       // bytes — размер выделенного блока
+        Deallocate,     // bytes — размер освобождённого блока
+        Reallocation,   // bytes — объём перенесённых при реаллокации данных
+    };
+
+    using Callback = void (*)(Event event, size_t bytes);
+
+    struct Counters {
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> deallocations{ 0 };
+        std::atomic<uint64_t> bytes_allocated{ 0 };
+        std::atomic<uint64_t> reallocation_events{ 0 };
+        std::atomic<uint64_t> bytes_relocated{ 0 };
+
+        void Reset() noexcept {
+            allocations = 0;
+            deallocations = 0;
+            bytes_allocated = 0;
+            reallocation_events = 0;
+            bytes_relocated = 0;
+        }
+    };
+
+    inline Counters& Get() noexcept {
+        static Counters counters;
+        return counters;
+    }
+
+    inline std::atomic<Callback>& CallbackSlot() noexcept {
+        static std::atomic<Callback> callback{ nullptr };
+        return callback;
+    }
+
+    inline void SetCallback(Callback callback) noexcept {
+        CallbackSlot().store(callback, std::memory_order_relaxed);
+    }
+
+    inline void Emit(Event event, size_t bytes) noexcept {
+        if (const Callback callback = CallbackSlot().load(std::memory_order_relaxed)) {
+            callback(event, bytes);
+        }
+    }
+
+    inline void OnAllocate(size_t bytes) noexcept {
+        Get().allocations.fetch_add(1, std::memory_order_relaxed);
+        Get().bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        Emit(Event::Allocate, bytes);
+    }
+
+    inline void OnDeallocate(size_t bytes) noexcept {
+        Get().deallocations.fetch_add(1, std::memory_order_relaxed);
+        Emit(Event::Deallocate, bytes);
+    }
+
+    inline void OnReallocation(size_t bytes_relocated) noexcept {
+        Get().reallocation_events.fetch_add(1, std::memory_order_relaxed);
+        Get().bytes_relocated.fetch_add(bytes_relocated, std::memory_order_relaxed);
+        Emit(Event::Reallocation, bytes_relocated);
+    }
+#else
+    inline void OnAllocate(size_t /*bytes*/) noexcept {
+    }
+
+    inline void OnDeallocate(size_t /*bytes*/) noexcept {
+    }
+
+    inline void OnReallocation(size_t /*bytes_relocated*/) noexcept {
+    }
+#endif
+
+}  // namespace vector_stats
+
+//Аллокатор по умолчанию.
+//Любой аллокатор для RawMemory обязан предоставлять статические Allocate(n)/Deallocate(buf, n);
+//необязательный Reallocate(buf, old_n, new_n) позволяет расширять блок на месте.
+//Для тривиально копируемых T память берётся у malloc, чтобы рост шёл через realloc
+//без полного копирования; для остальных типов — у глобальных operator new/delete.
+//В constant-evaluated контексте память берётся у std::allocator — так Vector
+//можно заполнять в constexpr-функциях, а готовые таблицы попадают в бинарник.
+template <typename T>
+struct NewDeleteAllocator {
+    // Выделяет сырую память под n элементов и возвращает указатель на неё
+    static constexpr T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            void* raw = std::malloc(n * sizeof(T));
+            if (raw == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(raw);
+        }
+        else {
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+    }
+
+    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
+    static constexpr void Deallocate(T* buf, size_t n) noexcept {
+        if (std::is_constant_evaluated()) {
+            if (buf != nullptr) {
+                std::allocator<T>{}.deallocate(buf, n);
+            }
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::free(buf);
+        }
+        else {
+            operator delete(buf);
+        }
+    }
+
+    // Расширяет блок до new_n элементов, по возможности на месте без копирования.
+    // Доступен только для тривиально копируемых T: realloc переносит байты, не вызывая
+    // конструкторов перемещения.
+    static T* Reallocate(T* buf, size_t /*old_n*/, size_t new_n)
+        requires std::is_trivially_copyable_v<T> {
+        void* raw = std::realloc(buf, new_n * sizeof(T));
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(raw);
+    }
+};
+
+//Политики роста вместимости для Vector.
+//Политика обязана предоставлять статические методы:
+//  Next(capacity, required, elem_size) — новая вместимость при нехватке места;
+//  Hint(required, elem_size)           — округление подсказки ReserveForAtLeast.
+//Обе величины — в элементах, elem_size — размер элемента в байтах.
+
+//Политика по умолчанию: удвоение вместимости, как и раньше.
+struct DoublingGrowth {
+    static constexpr size_t Next(size_t capacity, size_t required, size_t /*elem_size*/) noexcept {
+        return std::max(required, capacity == 0 ? size_t{1} : capacity * 2);
+    }
+
+    static constexpr size_t Hint(size_t required, size_t /*elem_size*/) noexcept {
+        return required;
+    }
+};
+
+//Рост с коэффициентом 1.5: меньше неиспользуемого запаса на гигабайтных векторах,
+//а освобождённые блоки чаще переиспользуются кучей.
+struct GoldenGrowth {
+    static constexpr size_t Next(size_t capacity, size_t required, size_t /*elem_size*/) noexcept {
+        return std::max({ required, size_t{1}, capacity + capacity / 2 });
+    }
+
+    static constexpr size_t Hint(size_t required, size_t /*elem_size*/) noexcept {
+        return required;
+    }
+};
+
+//Точный рост без запаса: каждая реаллокация выделяет ровно столько, сколько нужно.
+//Подходит для векторов, заполняемых один раз через AppendRange.
+struct ExactGrowth {
+    static constexpr size_t Next(size_t /*capacity*/, size_t required, size_t /*elem_size*/) noexcept {
+        return required;
+    }
+
+    static constexpr size_t Hint(size_t required, size_t /*elem_size*/) noexcept {
+        return required;
+    }
+};
+
+//Рост, квантованный по размеру страницы: вместимость округляется вверх так,
+//чтобы буфер занимал целое число страниц. Полезно с аллокаторами,
+//работающими крупными классами размеров (страницы, hugepages).
+template <size_t PageBytes = 4096>
+struct PageQuantizedGrowth {
+    static constexpr size_t Next(size_t capacity, size_t required, size_t elem_size) noexcept {
+        return Hint(DoublingGrowth::Next(capacity, required, elem_size), elem_size);
+    }
+
+    static constexpr size_t Hint(size_t required, size_t elem_size) noexcept {
+        const size_t bytes = ((required * elem_size + PageBytes - 1) / PageBytes) * PageBytes;
+        return bytes / elem_size;
+    }
+};
+
+//Трейт тривиальной перемещаемости (relocation): объекты типа T можно переносить
+//в новую память побайтово, не вызывая конструктор перемещения и деструктор
+//исходника. Верен по умолчанию для тривиально копируемых типов; пользователь
+//может специализировать его для собственных типов (например, небольших структур
+//со std::string), и тогда все реаллокационные пути Vector перенесут их одним
+//memmove — как это делают контейнеры abseil и folly.
+//Специализация допустима только для типов, чьи объекты не хранят указателей
+//на самих себя и не регистрируются где-либо по своему адресу.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
 
 template <typename T>
+inline constexpr bool is_trivially_relocatable_v = IsTriviallyRelocatable<T>::value;
+
+//Опциональный параллельный движок массового конструирования и разрушения.
+//Включается определением ADVANCED_VECTOR_PARALLEL перед включением заголовка;
+//без него приведённые ниже функции сводятся к обычным однопоточным алгоритмам
+//и не тянут <thread>. Параллельная ветка выбирается, только когда операция
+//над элементом гарантированно не бросает и объём работы превышает порог.
+#ifdef ADVANCED_VECTOR_PARALLEL
+#include <thread>
+#endif
+
+namespace vector_detail {
+
+#ifdef ADVANCED_VECTOR_PARALLEL
+    // Минимальный объём работы, при котором запуск потоков окупается
+    inline constexpr size_t kParallelThreshold = size_t{1} << 20;
+
+    // Верхняя граница числа рабочих потоков — размер массива потоков ниже
+    inline constexpr size_t kMaxParallelWorkers = 64;
+
+    // Делит диапазон [0, n) на число аппаратных потоков и выполняет fn(begin, count) в каждом
+    template <typename Fn>
+    void RunChunks(size_t n, Fn fn) {
+        // делитель зажат размером массива потоков: иначе на машинах с числом
+        // ядер больше kMaxParallelWorkers хвостовые куски остались бы невыполненными
+        const size_t workers = std::min<size_t>(
+            std::max<size_t>(1, std::thread::hardware_concurrency()), kMaxParallelWorkers);
+        const size_t chunk = (n + workers - 1) / workers;
+        std::thread threads[kMaxParallelWorkers];
+        size_t thread_count = 0;
+        for (size_t begin = chunk; begin < n && thread_count < kMaxParallelWorkers - 1; begin += chunk) {
+            const size_t count = std::min(chunk, n - begin);
+            threads[thread_count++] = std::thread(fn, begin, count);
+        }
+        // первый кусок — в текущем потоке, чтобы не простаивать
+        fn(0, std::min(chunk, n));
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads[i].join();
+        }
+    }
+#endif
+
+    template <typename T>
+    constexpr void ValueConstructN(T* dst, size_t n) {
+        if (std::is_constant_evaluated()) {
+            // std::uninitialized_* не являются constexpr — конструируем поэлементно
+            for (size_t i = 0; i < n; ++i) {
+                std::construct_at(dst + i);
+            }
+            return;
+        }
+#ifdef ADVANCED_VECTOR_PARALLEL
+        if constexpr (std::is_nothrow_default_constructible_v<T>) {
+            if (n >= kParallelThreshold) {
+                RunChunks(n, [dst](size_t begin, size_t count) {
+                    std::uninitialized_value_construct_n(dst + begin, count);
+                });
+                return;
+            }
+        }
+#endif
+        std::uninitialized_value_construct_n(dst, n);
+    }
+
+    template <typename T>
+    constexpr void CopyConstructN(const T* src, size_t n, T* dst) {
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                std::construct_at(dst + i, src[i]);
+            }
+            return;
+        }
+#ifdef ADVANCED_VECTOR_PARALLEL
+        if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+            if (n >= kParallelThreshold) {
+                RunChunks(n, [src, dst](size_t begin, size_t count) {
+                    std::uninitialized_copy_n(src + begin, count, dst + begin);
+                });
+                return;
+            }
+        }
+#endif
+        std::uninitialized_copy_n(src, n, dst);
+    }
+
+    template <typename T>
+    constexpr void MoveConstructN(T* src, size_t n, T* dst) {
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                std::construct_at(dst + i, std::move(src[i]));
+            }
+            return;
+        }
+        std::uninitialized_move_n(src, n, dst);
+    }
+
+    // Переносит n элементов в неинициализированную память dst и освобождает исходники:
+    // для тривиально перемещаемых типов — одним memmove без конструкторов и деструкторов,
+    // иначе перемещение/копирование с последующим разрушением источника
+    template <typename T>
+    constexpr void RelocateN(T* src, size_t n, T* dst) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n != 0) {
+                    // перенос байтов намеренный — трейт ручается за тип (void* глушит -Wclass-memaccess)
+                    std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+                }
+                return;
+            }
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            MoveConstructN(src, n, dst);
+        }
+        else {
+            CopyConstructN(src, n, dst);
+        }
+        std::destroy_n(src, n);
+    }
+
+    template <typename T>
+    constexpr void DestroyN(T* ptr, size_t n) noexcept {
+        if (std::is_constant_evaluated()) {
+            std::destroy_n(ptr, n);
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+#ifdef ADVANCED_VECTOR_PARALLEL
+            if constexpr (std::is_nothrow_destructible_v<T>) {
+                if (n >= kParallelThreshold) {
+                    RunChunks(n, [ptr](size_t begin, size_t count) {
+                        std::destroy_n(ptr + begin, count);
+                    });
+                    return;
+                }
+            }
+#endif
+            std::destroy_n(ptr, n);
+        }
+    }
+
+    // Программная предвыборка в кеш для чтения; вне GCC/Clang — пустая операция
+    inline void PrefetchRead(const void* addr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(addr, 0, 3);
+#else
+        (void)addr;
+#endif
+    }
+
+}  // namespace vector_detail
+
+//Политика гарантий безопасности исключений.
+//Strong — строгая гарантия, как и раньше: временные объекты и try/catch в путях вставки.
+//Fast — минимальный машинный код для типов, которые не бросают: элемент конструируется
+//сразу в целевой позиции, без временного объекта и блоков try/catch. Под Fast аргументы
+//Emplace/Insert не должны ссылаться на элементы этого же вектора при вставке в середину.
+enum class ExceptionSafety {
+    Strong,
+    Fast,
+};
+
+//Политика переиспользования буфера для Vector::AssignFrom.
+//PreserveOnThrow — строгая гарантия, как у operator=: новая копия строится рядом
+//со старым буфером, пик памяти — old + new.
+//MinimizePeak — пик памяти ограничен max(old, new): собственные элементы разрушаются
+//и буфер возвращается куче до выделения нового. При исключении из копирующего
+//конструктора вектор остаётся пустым (базовая гарантия).
+enum class ReusePolicy {
+    PreserveOnThrow,
+    MinimizePeak,
+};
+
+template <typename T, typename Allocator = NewDeleteAllocator<T>>
 class RawMemory {
 public:
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    explicit constexpr RawMemory(size_t capacity)
+        : buffer_(Allocator::Allocate(capacity))
         , capacity_(capacity) {
+        if (!std::is_constant_evaluated() && buffer_ != nullptr) {
+            vector_stats::OnAllocate(capacity_ * sizeof(T));
+        }
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    // Владение буфером уникально: копирование запрещено, перемещение передаёт буфер
+    RawMemory(const RawMemory&) = delete;
+    RawMemory& operator=(const RawMemory&) = delete;
+
+    constexpr RawMemory(RawMemory&& other) noexcept {
+        Swap(other);
+    }
+
+    constexpr RawMemory& operator=(RawMemory&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    constexpr ~RawMemory() {
+        if (!std::is_constant_evaluated() && buffer_ != nullptr) {
+            vector_stats::OnDeallocate(capacity_ * sizeof(T));
+        }
+        Allocator::Deallocate(buffer_, capacity_);
     }
 
-    T* operator+(size_t offset) noexcept {
+    constexpr T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    constexpr const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    constexpr const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    constexpr T& operator[](size_t index) noexcept {
         assert(index < capacity_);
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
+    constexpr void Swap(RawMemory& other) noexcept {
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
 
-    const T* GetAddress() const noexcept {
-        return buffer_;
+    // Отдаёт владение буфером вызывающему, не освобождая его; RawMemory пустеет.
+    // Учёт освобождения в статистике ложится на нового владельца.
+    constexpr T* Release() noexcept {
+        capacity_ = 0;
+        return std::exchange(buffer_, nullptr);
+    }
+
+    // Принимает владение буфером, ранее отданным через Release()
+    static constexpr RawMemory Adopt(T* buf, size_t capacity) noexcept {
+        RawMemory result;
+        result.buffer_ = buf;
+        result.capacity_ = capacity;
+        return result;
     }
 
-    T* GetAddress() noexcept {
+    constexpr const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
-        return capacity_;
+    constexpr T* GetAddress() noexcept {
+        return buffer_;
     }
 
-private:
-    // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    constexpr size_t Capacity() const {
+        return capacity_;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Пытается расширить блок до new_capacity средствами аллокатора (realloc-путь).
+    // Возвращает false, если аллокатор не умеет расширять блоки;
+    // содержимое буфера при успехе сохраняется побайтово.
+    constexpr bool TryReallocate(size_t new_capacity) {
+        if (std::is_constant_evaluated()) {
+            // compile-time выделения не расширяются — вызывающий берёт свежий буфер
+            return false;
+        }
+        if constexpr (requires { Allocator::Reallocate(buffer_, capacity_, new_capacity); }) {
+            buffer_ = Allocator::Reallocate(buffer_, capacity_, new_capacity);
+            vector_stats::OnDeallocate(capacity_ * sizeof(T));
+            vector_stats::OnAllocate(new_capacity * sizeof(T));
+            capacity_ = new_capacity;
+            return true;
+        }
+        else {
+            return false;
+        }
     }
 
+private:
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+template <typename T, typename Allocator = NewDeleteAllocator<T>, typename GrowthPolicy = DoublingGrowth,
+    ExceptionSafety Safety = ExceptionSafety::Strong>
 class Vector {
 public:
+    using value_type = T;
     using iterator = T*;
     using const_iterator = const T*;
 
-    iterator begin() noexcept {
+    constexpr iterator begin() noexcept {
         return data_.GetAddress();
     }
-    iterator end() noexcept {
+    constexpr iterator end() noexcept {
         return data_.GetAddress() + size_;
     }
-    const_iterator begin() const noexcept {
+    constexpr const_iterator begin() const noexcept {
         return data_.GetAddress();
     }
-    const_iterator end() const noexcept {
+    constexpr const_iterator end() const noexcept {
         return data_.GetAddress() + size_;
     }
-    const_iterator cbegin() const noexcept {
+    constexpr const_iterator cbegin() const noexcept {
         return data_.GetAddress();
     }
-    const_iterator cend() const noexcept {
+    constexpr const_iterator cend() const noexcept {
         return data_.GetAddress() + size_;
     }
 
@@ -105,40 +549,41 @@ public:
     //Конструктор, который создаёт вектор заданного размера. 
     //Вместимость созданного вектора равна его размеру, а элементы проинициализированы значением по умолчанию для типа T. 
     //Алгоритмическая сложность: O(размер вектора).
-    Vector(const size_t size)
+    constexpr Vector(const size_t size)
         : data_(size)
         , size_(size)
     {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        vector_detail::ValueConstructN(data_.GetAddress(), size);
     }
 
     //Копирующий конструктор. 
     //Создаёт копию элементов исходного вектора. 
     //Имеет вместимость, равную размеру исходного вектора, то есть выделяет память без запаса. 
     //Алгоритмическая сложность: O(размер исходного вектора).
-    Vector(const Vector& other)
+    constexpr Vector(const Vector& other)
         : data_(other.size_)
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+        vector_detail::CopyConstructN(other.data_.GetAddress(), size_, data_.GetAddress());
     }
 
-    Vector(Vector&& other) noexcept {
+    constexpr Vector(Vector&& other) noexcept {
         Swap(other);
     }
 
-    Vector& operator=(const Vector& rhs) {
+    constexpr Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
             if (rhs.size_ > data_.Capacity()) {
                 Vector rhs_copy(rhs);
                 Swap(rhs_copy);
             }
             else {
+                DetachIfShared();
                 size_t copy_size = std::min(size_, rhs.size_);
                 std::copy(rhs.data_.GetAddress(), rhs.data_.GetAddress() + copy_size, data_.GetAddress());
 
                 if (rhs.size_ > size_) {
-                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
+                    vector_detail::CopyConstructN(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
                 }
                 else {
                     std::destroy_n(data_.GetAddress() + rhs.size_, size_ - rhs.size_);
@@ -149,96 +594,399 @@ public:
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
+    constexpr Vector& operator=(Vector&& rhs) noexcept {
         if (this != &rhs) {
             Swap(rhs);
         }
         return *this;
     }
 
-    size_t Size() const noexcept {
+    constexpr size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
+    constexpr size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
-    const T& operator[](size_t index) const noexcept {
+    constexpr const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    constexpr T& operator[](size_t index) noexcept {
         assert(index < size_);
         return data_[index];
     }
 
     //Деструктор. Разрушает содержащиеся в векторе элементы и освобождает занимаемую ими память. 
     // Алгоритмическая сложность: O(размер вектора).
-    ~Vector() {
-        for (size_t j = 0; j < size_; ++j) {
-            (data_.GetAddress() + j)->~T();
+    constexpr ~Vector() {
+        if (!std::is_constant_evaluated() && shared_ != nullptr) {
+            // буфером и элементами владеет разделяемый блок снапшотов
+            data_.Release();
+            Unref(shared_);
+            return;
         }
+        // для тривиально разрушаемых типов цикла деструкторов нет вовсе,
+        // а для очень больших векторов разрушение может идти в несколько потоков
+        vector_detail::DestroyN(data_.GetAddress(), size_);
     }
 
     //Резервирует достаточно места, чтобы вместить количество элементов, равное capacity. 
     //Если новая вместимость не превышает текущую, метод не делает ничего. 
     //Алгоритмическая сложность: O(размер вектора). 
-    void Reserve(size_t capacity) {
+    constexpr void Reserve(size_t capacity) {
+        DetachIfShared();
         if (capacity > data_.Capacity()) {
-            RawMemory<T> new_data(capacity);
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                // realloc-путь: куча по возможности расширяет блок на месте,
+                // без временного сосуществования старого и нового буферов
+                if (data_.TryReallocate(capacity)) {
+                    vector_stats::OnReallocation(0);  // данные не переносились
+                    return;
+                }
             }
-            else {
-                std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+            RawMemory<T, Allocator> new_data(capacity);
+            if (!std::is_constant_evaluated() && data_.Capacity() != 0) {
+                vector_stats::OnReallocation(size_ * sizeof(T));
             }
-            std::destroy_n(data_.GetAddress(), size_);
+            // тривиально перемещаемые типы переносятся одним memmove,
+            // без поэлементных перемещений и вызовов деструкторов
+            vector_detail::RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
             data_.Swap(new_data);
         }
     }
 
-    void Swap(Vector& other) noexcept {
+    //Уменьшает вместимость до текущего размера, возвращая излишек памяти куче.
+    //Перенос элементов идёт по той же схеме, что и в Reserve (memcpy/перемещение/копирование).
+    //Алгоритмическая сложность: O(размер вектора).
+    void ShrinkToFit() {
+        ShrinkToCapacity(size_);
+    }
+
+    //Необязательная просьба уменьшить вместимость до n элементов (но не меньше размера).
+    //Если n не меньше текущей вместимости, метод не делает ничего.
+    //Алгоритмическая сложность: O(размер вектора).
+    void ShrinkToCapacity(size_t n) {
+        DetachIfShared();
+        const size_t target = std::max(n, size_);
+        if (target >= data_.Capacity()) {
+            return;
+        }
+        if (target == 0) {
+            RawMemory<T, Allocator> released;
+            data_.Swap(released);
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // realloc в меньшую сторону обычно усекает блок на месте
+            if (data_.TryReallocate(target)) {
+                return;
+            }
+        }
+        RawMemory<T, Allocator> new_data(target);
+        vector_detail::RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+        data_.Swap(new_data);
+    }
+
+    //Подсказка о будущем размере: резервирует не меньше n элементов, минуя лестницу удвоений.
+    //Итоговая вместимость округляется политикой роста (например, до целого числа страниц).
+    //Алгоритмическая сложность: O(размер вектора).
+    void ReserveForAtLeast(size_t n) {
+        if (n > data_.Capacity()) {
+            Reserve(GrowthPolicy::Hint(n, sizeof(T)));
+        }
+    }
+
+    constexpr void Swap(Vector& other) noexcept {
         data_.Swap(other.data_);
         std::swap(size_, other.size_);
+        std::swap(shared_, other.shared_);
+    }
+
+    //Прямой доступ к непрерывному буферу элементов — например, чтобы читать данные
+    //напрямую через recv/pread после ResizeUninitialized.
+    constexpr T* Data() noexcept {
+        return data_.GetAddress();
+    }
+
+    constexpr const T* Data() const noexcept {
+        return data_.GetAddress();
+    }
+
+    //Представление содержимого как std::span — для передачи в SIMD-ядра
+    //и обобщённые алгоритмы без привязки к типу контейнера.
+    operator std::span<T>() noexcept {
+        return std::span<T>(Data(), size_);
+    }
+
+    operator std::span<const T>() const noexcept {
+        return std::span<const T>(Data(), size_);
+    }
+
+    //Массовые операции над непрерывным буфером. Контейнер знает собственную
+    //раскладку, поэтому ядра написаны простыми плотными циклами без зависимостей
+    //между итерациями — компилятор автовекторизует их под целевую платформу,
+    //а для подходящих типов работа сводится к memcpy/memcmp.
+
+    //Записывает value во все элементы.
+    //Алгоритмическая сложность: O(размер вектора).
+    void Fill(const T& value) {
+        DetachIfShared();
+        std::fill_n(Data(), size_, value);
+    }
+
+    //Заменяет содержимое вектора элементами span.
+    //Алгоритмическая сложность: O(размер span + текущий размер вектора).
+    void CopyFrom(std::span<const T> src) {
+        DetachIfShared();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (src.size() <= data_.Capacity()) {
+                std::memcpy(Data(), src.data(), src.size() * sizeof(T));
+                size_ = src.size();
+                return;
+            }
+        }
+        Assign(src.begin(), src.end());
+    }
+
+    //Поэлементное сравнение с другим вектором.
+    //Для типов с уникальным представлением сводится к одному memcmp.
+    //Алгоритмическая сложность: O(размер вектора).
+    bool Equals(const Vector& other) const {
+        if (size_ != other.size_) {
+            return false;
+        }
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            return size_ == 0
+                || std::memcmp(Data(), other.Data(), size_ * sizeof(T)) == 0;
+        }
+        else {
+            return std::equal(Data(), Data() + size_, other.Data());
+        }
+    }
+
+    //Редукции для арифметических типов. Вектор не должен быть пустым (Min/Max).
+    //Алгоритмическая сложность: O(размер вектора).
+    T Min() const noexcept
+        requires std::is_arithmetic_v<T> {
+        assert(size_ != 0);
+        T result = Data()[0];
+        for (size_t i = 1; i < size_; ++i) {
+            result = Data()[i] < result ? Data()[i] : result;
+        }
+        return result;
     }
 
-    void Resize(size_t new_size) {
+    T Max() const noexcept
+        requires std::is_arithmetic_v<T> {
+        assert(size_ != 0);
+        T result = Data()[0];
+        for (size_t i = 1; i < size_; ++i) {
+            result = result < Data()[i] ? Data()[i] : result;
+        }
+        return result;
+    }
+
+    T Sum() const noexcept
+        requires std::is_arithmetic_v<T> {
+        T result{};
+        for (size_t i = 0; i < size_; ++i) {
+            result += Data()[i];
+        }
+        return result;
+    }
+
+    //Линейный обход с программной предвыборкой: пока callback обрабатывает
+    //текущий элемент, данные в kPrefetchAheadBytes впереди уже едут в кеш.
+    //Для холодных буферов (mmap, вытесненные страницы) от kMadviseBytes
+    //вперёд дополнительно отдаётся подсказка madvise(MADV_SEQUENTIAL и
+    //MADV_WILLNEED), чтобы ядро читало страницы с опережением.
+    //Выигрывает на сканах, ограниченных латентностью памяти; на горячих
+    //данных в кеше накладные расходы предвыборки пренебрежимы.
+    //Алгоритмическая сложность: O(размер вектора).
+    template <typename Callback>
+    void ForEachPrefetched(Callback callback) const {
+        AdviseSequentialScan();
+        const char* const limit = reinterpret_cast<const char*>(Data() + size_);
+        const T* p = Data();
+        // основной цикл: предвыборка безусловна, пока не догоняет конец буфера
+        for (; reinterpret_cast<const char*>(p) + kPrefetchAheadBytes < limit; ++p) {
+            vector_detail::PrefetchRead(reinterpret_cast<const char*>(p) + kPrefetchAheadBytes);
+            callback(*p);
+        }
+        for (; p != Data() + size_; ++p) {
+            callback(*p);
+        }
+    }
+
+    template <typename Callback>
+    void ForEachPrefetched(Callback callback) {
+        AdviseSequentialScan();
+        const char* const limit = reinterpret_cast<const char*>(Data() + size_);
+        T* p = Data();
+        for (; reinterpret_cast<const char*>(p) + kPrefetchAheadBytes < limit; ++p) {
+            vector_detail::PrefetchRead(reinterpret_cast<const char*>(p) + kPrefetchAheadBytes);
+            callback(*p);
+        }
+        for (; p != Data() + size_; ++p) {
+            callback(*p);
+        }
+    }
+
+    //Изменяет размер вектора, не инициализируя новые элементы: их содержимое не определено,
+    //вызывающая сторона обязана перезаписать его до чтения.
+    //Доступен только для тривиальных типов, у которых нет конструкторов и деструкторов.
+    //Алгоритмическая сложность: O(размер вектора при реаллокации), иначе O(1).
+    void ResizeUninitialized(size_t new_size)
+        requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T> {
+        DetachIfShared();
+        Reserve(new_size);
+        size_ = new_size;
+    }
+
+    constexpr void Resize(size_t new_size) {
+        DetachIfShared();
         if (new_size > size_) {
             Reserve(new_size);
-            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+            vector_detail::ValueConstructN(data_.GetAddress() + size_, new_size - size_);
         }
         else {
-            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+            vector_detail::DestroyN(data_.GetAddress() + new_size, size_ - new_size);
         }
         size_ = new_size;
     }
 
-    iterator Insert(const_iterator pos, const T& value) {
+    //Добавляет элементы диапазона [first, last) в конец вектора.
+    //Нужная вместимость вычисляется заранее, поэтому реаллокация происходит не более одного раза,
+    //а элементы конструируются одним проходом без поэлементных проверок вместимости.
+    //Алгоритмическая сложность: O(размер диапазона + размер вектора при реаллокации).
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        DetachIfShared();
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+        if (size_ + count > data_.Capacity()) {
+            // рост по политике, чтобы серия мелких до-вставок не реаллоцировала каждый раз
+            Reserve(GrowthPolicy::Next(data_.Capacity(), size_ + count, sizeof(T)));
+        }
+        if constexpr (std::contiguous_iterator<InputIt> && std::is_trivially_copyable_v<T>
+            && std::is_same_v<std::remove_cvref_t<std::iter_reference_t<InputIt>>, T>) {
+            std::memcpy(data_.GetAddress() + size_, std::to_address(first), count * sizeof(T));
+        }
+        else {
+            std::uninitialized_copy_n(first, count, data_.GetAddress() + size_);
+        }
+        size_ += count;
+    }
+
+    //Заменяет содержимое вектора элементами диапазона [first, last).
+    //Существующий буфер переиспользуется, если вместимости достаточно;
+    //иначе выделяется ровно один новый буфер без запаса.
+    //Алгоритмическая сложность: O(размер диапазона + текущий размер вектора).
+    template <typename InputIt>
+    void Assign(InputIt first, InputIt last) {
+        DetachIfShared();
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > data_.Capacity()) {
+            // строим новый вектор и забираем его буфер — строгая гарантия сохраняется
+            Vector new_vector;
+            new_vector.Reserve(count);
+            new_vector.AppendRange(first, last);
+            Swap(new_vector);
+        }
+        else {
+            const size_t copy_size = std::min(size_, count);
+            std::copy_n(first, copy_size, data_.GetAddress());
+            if (count > size_) {
+                std::uninitialized_copy_n(std::next(first, copy_size), count - copy_size,
+                    data_.GetAddress() + size_);
+            }
+            else if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy_n(data_.GetAddress() + count, size_ - count);
+            }
+            size_ = count;
+        }
+    }
+
+    //Присваивание с явной политикой переиспользования памяти.
+    //Пока вместимости хватает, копирование всегда идёт в существующий буфер.
+    //При нехватке места PreserveOnThrow повторяет operator= (строгая гарантия,
+    //пик old + new), а MinimizePeak освобождает собственный буфер до выделения
+    //нового, ограничивая пик памяти величиной max(old, new) — критично
+    //для присваиваний почти полных векторов на почти полной куче.
+    //Алгоритмическая сложность: O(размер обоих векторов).
+    void AssignFrom(const Vector& other, ReusePolicy policy) {
+        if (this == &other) {
+            return;
+        }
+        DetachIfShared();
+        if (other.size_ <= data_.Capacity()) {
+            *this = other;  // in-place ветка operator= уже переиспользует буфер
+            return;
+        }
+        if (policy == ReusePolicy::PreserveOnThrow) {
+            Vector other_copy(other);
+            Swap(other_copy);
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // realloc-путь: блок расширяется на месте, второй буфер не появляется вовсе
+            if (data_.TryReallocate(other.size_)) {
+                std::memcpy(data_.GetAddress(), other.data_.GetAddress(), other.size_ * sizeof(T));
+                size_ = other.size_;
+                return;
+            }
+        }
+        // MinimizePeak: сначала возвращаем свой буфер куче, затем выделяем новый
+        vector_detail::DestroyN(data_.GetAddress(), size_);
+        size_ = 0;
+        {
+            RawMemory<T, Allocator> released;
+            data_.Swap(released);
+        }
+        RawMemory<T, Allocator> new_data(other.size_);
+        vector_detail::CopyConstructN(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+        data_.Swap(new_data);
+        size_ = other.size_;
+    }
+
+    constexpr iterator Insert(const_iterator pos, const T& value) {
         return Emplace(pos, value);
     }
 
-    iterator Insert(const_iterator pos, T&& value) {
+    constexpr iterator Insert(const_iterator pos, T&& value) {
         return Emplace(pos, std::move(value));
     }
 
-    void PushBack(const T& value) {
+    constexpr void PushBack(const T& value) {
         EmplaceBack(value);
     }
 
-    void PushBack(T&& value) {
+    constexpr void PushBack(T&& value) {
         EmplaceBack(std::forward<T>(value));
     }
 
     template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
-        return *Emplace(end(), std::forward<Args>(args)...);
+    constexpr T& EmplaceBack(Args&&... args) {
+        DetachIfShared();
+        // горячий путь вставки в конец: проверка вместимости, размещающий new, инкремент размера
+        if (size_ < data_.Capacity()) {
+            std::construct_at(data_.GetAddress() + size_, std::forward<Args>(args)...);
+            return data_[size_++];
+        }
+        return EmplaceBackWithReallocation(std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    iterator Emplace(const_iterator pos, Args&&... args) {
-        // индекс позиции вставки
+    constexpr iterator Emplace(const_iterator pos, Args&&... args) {
+        // индекс позиции вставки; вычисляется до отвязки от снапшотов —
+        // DetachIfShared подменяет буфер, и pos стал бы указывать в старый
         ptrdiff_t index = pos - begin();
+        DetachIfShared();
+        pos = begin() + index;
 
         if (size_ < data_.Capacity()) {
             // НЕ требуется реаллокация памяти
@@ -253,28 +1001,513 @@ public:
         return begin() + index;
     }
 
+    //Сеанс параллельного заполнения вектора из нескольких потоков-производителей.
+    //Вместимость резервируется один раз при открытии сеанса, после чего потоки
+    //конструируют элементы в буфер через атомарный курсор, без блокировок.
+    //Правила: пока сеанс открыт, никакие другие операции над вектором не допускаются;
+    //каждый выданный слот обязан быть сконструирован (конструкторы не должны бросать);
+    //Commit() вызывается один раз после завершения всех потоков и публикует размер.
+    class ParallelFillSession {
+    public:
+        //Конструирует элемент в следующем свободном слоте. Потокобезопасно.
+        template <typename... Args>
+        T& Emplace(Args&&... args) {
+            const size_t index = cursor_.fetch_add(1, std::memory_order_relaxed);
+            assert(index < vector_.data_.Capacity());
+            T* ptr = vector_.data_.GetAddress() + index;
+            new (ptr) T(std::forward<Args>(args)...);
+            return *ptr;
+        }
+
+        //Выдаёт непрерывный диапазон из count слотов для пакетного конструирования.
+        //Каждый слот диапазона обязан быть сконструирован до Commit().
+        T* AcquireRange(size_t count) noexcept {
+            const size_t index = cursor_.fetch_add(count, std::memory_order_relaxed);
+            assert(index + count <= vector_.data_.Capacity());
+            return vector_.data_.GetAddress() + index;
+        }
+
+        //Публикует итоговый размер вектора. Вызывать после join всех потоков-производителей.
+        void Commit() noexcept {
+            vector_.size_ = cursor_.load(std::memory_order_relaxed);
+            committed_ = true;
+        }
+
+        ~ParallelFillSession() {
+            if (!committed_) {
+                Commit();
+            }
+        }
+
+        ParallelFillSession(const ParallelFillSession&) = delete;
+        ParallelFillSession& operator=(const ParallelFillSession&) = delete;
+
+    private:
+        friend class Vector;
+
+        ParallelFillSession(Vector& vector, size_t capacity)
+            : vector_(vector)
+            , cursor_(vector.size_) {
+            vector.DetachIfShared();
+            vector.Reserve(capacity);
+        }
+
+        Vector& vector_;
+        std::atomic<size_t> cursor_;
+        bool committed_ = false;
+    };
+
+    //Открывает сеанс параллельного заполнения с вместимостью не меньше capacity.
+    ParallelFillSession StartParallelFill(size_t capacity) {
+        return ParallelFillSession(*this, capacity);
+    }
+
+    //Сеанс пакетной вставки в середину. Одиночный Emplace сдвигает весь хвост
+    //на каждую вставку, и k вставок стоят O(n*k); сеанс накапливает пары
+    //(индекс, значение) и применяет их одним слиянием справа налево —
+    //O(n + k log k). Индекс — позиция в исходном векторе (как у Insert);
+    //вставки с равными индексами ложатся в порядке добавления, индекс за
+    //концом вектора означает вставку в конец.
+    //Пока сеанс открыт, другие операции над вектором не допускаются.
+    //Commit() обязателен и вызывается явно: он выделяет память и перемещает
+    //элементы, то есть может бросить, поэтому из деструктора не вызывается.
+    //Сеанс, разрушенный без Commit(), отбрасывает накопленные вставки
+    //(в отладочной сборке это ловит assert).
+    //Commit() даёт базовую гарантию: при исключении из перемещения элементов
+    //вектор остаётся валидным, но порядок элементов не определён.
+    class InsertBatchSession {
+    public:
+        //Добавляет вставку значения перед позицией index исходного вектора.
+        template <typename... Args>
+        void Add(size_t index, Args&&... args) {
+            entries_.EmplaceBack(index, T(std::forward<Args>(args)...));
+        }
+
+        //Применяет накопленные вставки одним проходом.
+        void Commit() {
+            if (committed_) {
+                return;
+            }
+            committed_ = true;
+            const size_t k = entries_.Size();
+            if (k == 0) {
+                return;
+            }
+            vector_.DetachIfShared();
+            std::stable_sort(entries_.begin(), entries_.end(),
+                [](const Entry& lhs, const Entry& rhs) { return lhs.index < rhs.index; });
+            const size_t new_size = vector_.size_ + k;
+            if (new_size <= vector_.data_.Capacity()) {
+                CommitInPlace(new_size);
+            }
+            else {
+                CommitWithReallocation(new_size);
+            }
+        }
+
+        ~InsertBatchSession() {
+            // Commit() может бросить и потому не вызывается из деструктора:
+            // незафиксированные вставки отбрасываются
+            assert(committed_ || entries_.Size() == 0);
+        }
+
+        InsertBatchSession(const InsertBatchSession&) = delete;
+        InsertBatchSession& operator=(const InsertBatchSession&) = delete;
+
+    private:
+        friend class Vector;
+
+        struct Entry {
+            size_t index;
+            T value;
+        };
+
+        explicit InsertBatchSession(Vector& vector)
+            : vector_(vector) {
+        }
+
+        // Вместимости хватает: хвосты сдвигаются вправо, каждая ячейка трогается один раз
+        void CommitInPlace(size_t new_size) {
+            const size_t old_size = vector_.size_;
+            T* data = vector_.data_.GetAddress();
+            size_t src = old_size;   // элементы [0, src) ещё на исходных местах
+            size_t dst = new_size;   // позиции [dst, new_size) уже заполнены
+            try {
+                for (size_t e = entries_.Size(); e-- > 0;) {
+                    const size_t index = std::min(entries_[e].index, old_size);
+                    while (src > index) {
+                        --src;
+                        --dst;
+                        FillSlot(data, dst, std::move(data[src]), old_size);
+                    }
+                    --dst;
+                    FillSlot(data, dst, std::move(entries_[e].value), old_size);
+                }
+            }
+            catch (...) {
+                // слоты за старым концом, уже успевшие сконструироваться, разрушаются,
+                // размер не меняется — вектор остаётся валидным
+                const size_t constructed_from = std::max(dst + 1, old_size);
+                std::destroy_n(data + constructed_from, new_size - constructed_from);
+                throw;
+            }
+            vector_.size_ = new_size;
+        }
+
+        // Вместимости не хватает: слияние старого буфера и вставок в свежий буфер,
+        // непрерывные участки исходника переносятся RelocateN
+        void CommitWithReallocation(size_t new_size) {
+            const size_t old_size = vector_.size_;
+            RawMemory<T, Allocator> new_data(
+                GrowthPolicy::Next(vector_.data_.Capacity(), new_size, sizeof(T)));
+            T* src = vector_.data_.GetAddress();
+            T* dst = new_data.GetAddress();
+            size_t consumed = 0;
+            try {
+                for (size_t e = 0; e < entries_.Size(); ++e) {
+                    const size_t index = std::min(entries_[e].index, old_size);
+                    const size_t run = index - consumed;
+                    vector_detail::RelocateN(src + consumed, run, dst);
+                    consumed += run;
+                    dst += run;
+                    std::construct_at(dst, std::move(entries_[e].value));
+                    ++dst;
+                }
+                vector_detail::RelocateN(src + consumed, old_size - consumed, dst);
+            }
+            catch (...) {
+                // уже перенесённые участки разрушены в исходнике; добиваем остаток
+                // и свежий буфер, вектор остаётся валидным, но пустым
+                std::destroy_n(src + consumed, old_size - consumed);
+                std::destroy_n(new_data.GetAddress(), static_cast<size_t>(dst - new_data.GetAddress()));
+                vector_.size_ = 0;
+                throw;
+            }
+            vector_.data_.Swap(new_data);
+            vector_.size_ = new_size;
+        }
+
+        // Перемещает value в ячейку index: за старым концом — конструирование
+        // в сырой памяти, внутри — присваивание живому элементу
+        static void FillSlot(T* data, size_t index, T&& value, size_t old_size) {
+            if (index >= old_size) {
+                std::construct_at(data + index, std::move(value));
+            }
+            else {
+                data[index] = std::move(value);
+            }
+        }
+
+        Vector& vector_;
+        Vector<Entry> entries_;
+        bool committed_ = false;
+    };
+
+    //Открывает сеанс пакетной вставки.
+    InsertBatchSession StartInsertBatch() {
+        return InsertBatchSession(*this);
+    }
+
+private:
+    // Блок совместного владения буфером между вектором и снапшотами — см. TakeSnapshot
+    struct SharedBlock;
+
+public:
+    //Снапшот: дешёвый разделяемый read-only срез вектора на момент вызова
+    //TakeSnapshot(). Вместо полного копирования буфера снапшот берёт
+    //совместное владение текущим RawMemory (атомарный счётчик ссылок),
+    //а вектор откладывает копирование до первой следующей мутации —
+    //copy-on-write. Для read-mostly аналитики стоимость снапшота падает
+    //с O(размер вектора) до O(1).
+    //Снапшот можно копировать и читать из любых потоков; последний
+    //владелец (вектор или снапшот) разрушает элементы и буфер.
+    class Snapshot {
+    public:
+        Snapshot(const Snapshot& other) noexcept
+            : block_(other.block_)
+            , size_(other.size_) {
+            if (block_ != nullptr) {
+                block_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Snapshot(Snapshot&& other) noexcept
+            : block_(std::exchange(other.block_, nullptr))
+            , size_(std::exchange(other.size_, 0)) {
+        }
+
+        Snapshot& operator=(const Snapshot& rhs) noexcept {
+            if (this != &rhs) {
+                Snapshot rhs_copy(rhs);
+                std::swap(block_, rhs_copy.block_);
+                std::swap(size_, rhs_copy.size_);
+            }
+            return *this;
+        }
+
+        Snapshot& operator=(Snapshot&& rhs) noexcept {
+            if (this != &rhs) {
+                std::swap(block_, rhs.block_);
+                std::swap(size_, rhs.size_);
+            }
+            return *this;
+        }
+
+        ~Snapshot() {
+            Unref(block_);
+        }
+
+        size_t Size() const noexcept {
+            return size_;
+        }
+
+        const T& operator[](size_t index) const noexcept {
+            assert(index < size_);
+            return block_->mem.GetAddress()[index];
+        }
+
+        const T* begin() const noexcept {
+            return block_ != nullptr ? block_->mem.GetAddress() : nullptr;
+        }
+
+        const T* end() const noexcept {
+            return begin() + size_;
+        }
+
+    private:
+        friend class Vector;
+
+        Snapshot(SharedBlock* block, size_t size) noexcept
+            : block_(block)
+            , size_(size) {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        SharedBlock* block_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    //Возвращает снапшот текущего содержимого за O(1): буфер переходит в
+    //совместное владение, полного копирования элементов не происходит.
+    //Вектор остаётся полностью работоспособным: первая же мутация
+    //(EmplaceBack, Erase, Resize и т.д.) скопирует элементы в свежий буфер
+    //и отвяжет вектор от снапшотов. Копирование при отвязке может бросить;
+    //внутри noexcept-мутаторов (PopBack, Erase nothrow-move типов) это
+    //приведёт к terminate, поэтому режим снапшотов рассчитан на типы
+    //с небросающим копированием. Запись через operator[] отвязку не
+    //выполняет — перед точечной записью вызовите Detach() явно.
+    Snapshot TakeSnapshot() requires std::is_copy_constructible_v<T> {
+        if (shared_ == nullptr) {
+            T* buf = data_.GetAddress();
+            const size_t capacity = data_.Capacity();
+            SharedBlock* block = new SharedBlock();
+            block->mem = std::move(data_);
+            block->size = size_;
+            // вектор продолжает читать и дописывать тот же буфер как не-владелец:
+            // владение снято через Release() при отвязке и в деструкторе
+            data_ = RawMemory<T, Allocator>::Adopt(buf, capacity);
+            shared_ = block;
+        }
+        return Snapshot(shared_, size_);
+    }
+
+    //Отдаёт владение буфером вместе с живыми элементами вызывающему: вектор
+    //пустеет за O(1), разрушение count элементов и освобождение буфера ложатся
+    //на получателя (см. ReleaseAsync в async_reclaim.h). Если буфер разделён
+    //со снапшотами, снимается только наша доля владения и возвращается пустой
+    //RawMemory — элементы разрушит последний снапшот.
+    RawMemory<T, Allocator> ReleaseStorage(size_t& count) noexcept {
+        if (shared_ != nullptr) {
+            data_.Release();
+            Unref(std::exchange(shared_, nullptr));
+            count = 0;
+            size_ = 0;
+            return {};
+        }
+        count = std::exchange(size_, 0);
+        RawMemory<T, Allocator> result;
+        result.Swap(data_);
+        return result;
+    }
+
+    //Принудительно отвязывает вектор от живых снапшотов, скопировав элементы
+    //в собственный буфер. После вызова запись через operator[] безопасна.
+    //Алгоритмическая сложность: O(размер вектора), если снапшоты есть, иначе O(1).
+    void Detach() {
+        DetachIfShared();
+    }
+
     iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
-        T* non_const_pos = const_cast<T*>(pos);  // Преобразуем const_iterator в iterator
-        std::move(non_const_pos + 1, end(), non_const_pos);  // Перемещаем элементы на одну позицию влево
-        (data_ + size_ - 1)->~T();  // Разрушаем последний элемент
+        // позиция фиксируется индексом до отвязки: после неё pos указывал бы
+        // в буфер, которым владеют снапшоты
+        const ptrdiff_t index = pos - begin();
+        DetachIfShared();
+        T* non_const_pos = begin() + index;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // хвост сдвигается одним memmove, деструктор последнего элемента не нужен
+            std::memmove(non_const_pos, non_const_pos + 1, (end() - non_const_pos - 1) * sizeof(T));
+        }
+        else {
+            std::move(non_const_pos + 1, end(), non_const_pos);  // Перемещаем элементы на одну позицию влево
+            (data_ + size_ - 1)->~T();  // Разрушаем последний элемент
+        }
         --size_;
         return non_const_pos;
     }
 
-    void PopBack() noexcept {
+    //Удаляет элементы диапазона [first, last) одним сдвигом хвоста.
+    //Алгоритмическая сложность: O(расстояние от first до конца вектора).
+    iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const ptrdiff_t first_index = first - begin();
+        const ptrdiff_t last_index = last - begin();
+        DetachIfShared();
+        T* non_const_first = begin() + first_index;
+        T* non_const_last = begin() + last_index;
+        const size_t count = static_cast<size_t>(non_const_last - non_const_first);
+        if (count == 0) {
+            return non_const_first;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(non_const_first, non_const_last, (end() - non_const_last) * sizeof(T));
+        }
+        else {
+            std::move(non_const_last, end(), non_const_first);
+            std::destroy_n(end() - count, count);
+        }
+        size_ -= count;
+        return non_const_first;
+    }
+
+    //Удаляет все элементы, удовлетворяющие предикату, одним уплотняющим проходом.
+    //Возвращает количество удалённых элементов.
+    //Алгоритмическая сложность: O(размер вектора) независимо от числа удалений.
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        DetachIfShared();
+        T* write = begin();
+        for (T* read = begin(); read != end(); ++read) {
+            if (!pred(*read)) {
+                if (write != read) {
+                    *write = std::move(*read);
+                }
+                ++write;
+            }
+        }
+        const size_t removed = static_cast<size_t>(end() - write);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::destroy_n(write, removed);
+        }
+        size_ -= removed;
+        return removed;
+    }
+
+    constexpr void PopBack() noexcept {
+        DetachIfShared();
         assert(size_ != 0);
         std::destroy_at(data_.GetAddress() + size_ - 1);
         --size_;
     }
 
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Allocator> data_;
     size_t size_ = 0;
+    SharedBlock* shared_ = nullptr;
+
+    struct SharedBlock {
+        RawMemory<T, Allocator> mem;
+        size_t size = 0;
+        std::atomic<size_t> refs{ 1 };
+
+        ~SharedBlock() {
+            vector_detail::DestroyN(mem.GetAddress(), size);
+        }
+    };
+
+    // Дистанция предвыборки ForEachPrefetched — восемь кеш-линий x86-64
+    static constexpr size_t kPrefetchAheadBytes = 8 * 64;
+    // Порог, с которого перед сканом имеет смысл подсказка ядру
+    static constexpr size_t kMadviseBytes = size_t{1} << 20;
+
+    // Сообщает ядру о предстоящем линейном скане большого буфера.
+    // Ошибки игнорируются: madvise — подсказка, а не обязательство.
+    void AdviseSequentialScan() const noexcept {
+#ifdef __linux__
+        const size_t bytes = size_ * sizeof(T);
+        if (bytes < kMadviseBytes) {
+            return;
+        }
+        // madvise требует выравнивания адреса по границе страницы
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(data_.GetAddress());
+        const uintptr_t page = addr & ~(uintptr_t{4096} - 1);
+        void* start = reinterpret_cast<void*>(page);
+        const size_t len = bytes + (addr - page);
+        ::madvise(start, len, MADV_SEQUENTIAL);
+        ::madvise(start, len, MADV_WILLNEED);
+#endif
+    }
+
+    static void Unref(SharedBlock* block) noexcept {
+        if (block != nullptr && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete block;
+        }
+    }
+
+    // Быстрая проверка на горячем пути мутаторов: в обычном режиме shared_ == nullptr
+    // и проверка сводится к одному предсказуемому переходу
+    constexpr void DetachIfShared() {
+        if (!std::is_constant_evaluated() && shared_ != nullptr) {
+            DetachSlow();
+        }
+    }
+
+    // Холодный путь copy-on-write: копирует элементы в собственный буфер
+    // и отпускает разделяемый блок; элементы снапшотов остаются на месте
+    ADVANCED_VECTOR_NOINLINE void DetachSlow() {
+        // для типов без копирования TakeSnapshot недоступен и shared_ всегда нулевой
+        if constexpr (std::is_copy_constructible_v<T>) {
+            RawMemory<T, Allocator> new_data(data_.Capacity());
+            vector_detail::CopyConstructN(data_.GetAddress(), size_, new_data.GetAddress());
+            data_.Release();
+            data_.Swap(new_data);
+            Unref(std::exchange(shared_, nullptr));
+        }
+    }
+
+    // Холодный путь EmplaceBack: реаллокация вынесена в отдельную неинлайнируемую функцию,
+    // чтобы горячий путь сводился к проверке, размещающему new и инкременту
+    template <typename... Args>
+    ADVANCED_VECTOR_NOINLINE constexpr T& EmplaceBackWithReallocation(Args&&... args) {
+        EmplaceWithReallocation(static_cast<ptrdiff_t>(size_), end(), std::forward<Args>(args)...);
+        ++size_;
+        return data_[size_ - 1];
+    }
 
     template <typename... Args>
-    void EmplaceWithoutReallocation(const auto index, [[maybe_unused]] const_iterator pos, Args&&... args) {
+    constexpr void EmplaceWithoutReallocation(const auto index, [[maybe_unused]] const_iterator pos, Args&&... args) {
         if (pos == end()) {
-            new (data_.GetAddress() + size_) T(std::forward<Args>(args)...);
+            std::construct_at(data_.GetAddress() + size_, std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_trivially_copyable_v<T>) {
+            // создание временного объекта до сдвига,
+            // если вставляемый элемент уже существует в векторе
+            T temp(std::forward<Args>(args)...);
+            if (!std::is_constant_evaluated()) {
+                std::memmove(data_.GetAddress() + index + 1, data_.GetAddress() + index,
+                    (size_ - index) * sizeof(T));
+                std::memcpy(data_.GetAddress() + index, &temp, sizeof(T));
+                return;
+            }
+            // compile-time ветка: memmove недоступен, сдвигаем поэлементно
+            std::construct_at(data_.GetAddress() + size_, std::move(*(end() - 1)));
+            std::move_backward(begin() + index, end() - 1, end());
+            data_[index] = std::move(temp);
+        }
+        else if constexpr (Safety == ExceptionSafety::Fast) {
+            // без временного объекта: элемент конструируется прямо в образовавшемся разрыве
+            std::construct_at(data_.GetAddress() + size_, std::move(*(end() - 1)));
+            std::move_backward(begin() + index, end() - 1, end());
+            std::destroy_at(data_.GetAddress() + index);
+            std::construct_at(data_.GetAddress() + index, std::forward<Args>(args)...);
         }
         else {
             // создание временного объекта, 
@@ -282,7 +1515,7 @@ private:
             T temp(std::forward<Args>(args)...);
 
             // создание нового элемента на месте последнего элемента 
-            new (data_.GetAddress() + size_) T(std::forward<T>(*(end() - 1)));
+            std::construct_at(data_.GetAddress() + size_, std::forward<T>(*(end() - 1)));
 
             // перемещение элементов назад
             std::move_backward(begin() + index, end() - 1, end());
@@ -293,17 +1526,65 @@ private:
     }
 
     template <typename... Args>
-    void EmplaceWithReallocation(const auto index, [[maybe_unused]] const_iterator pos, Args&&... args) {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+    constexpr void EmplaceWithReallocation(const auto index, [[maybe_unused]] const_iterator pos, Args&&... args) {
+        const size_t new_capacity = GrowthPolicy::Next(data_.Capacity(), size_ + 1, sizeof(T));
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                // временный объект создаётся до realloc: args могут ссылаться на элемент вектора
+                T temp(std::forward<Args>(args)...);
+                if (data_.TryReallocate(new_capacity)) {
+                    // блок расширен на месте, осталось раздвинуть хвост и вписать элемент
+                    vector_stats::OnReallocation((size_ - index) * sizeof(T));
+                    std::memmove(data_.GetAddress() + index + 1, data_.GetAddress() + index,
+                        (size_ - index) * sizeof(T));
+                    std::memcpy(data_.GetAddress() + index, &temp, sizeof(T));
+                    return;
+                }
+                // обе половины старого буфера переносятся memcpy, без деструкторов
+                RawMemory<T, Allocator> new_data(new_capacity);
+                if (data_.Capacity() != 0) {
+                    vector_stats::OnReallocation(size_ * sizeof(T));
+                }
+                std::memcpy(new_data.GetAddress() + index, &temp, sizeof(T));
+                if (index != 0) {
+                    std::memcpy(new_data.GetAddress(), data_.GetAddress(), index * sizeof(T));
+                }
+                if (static_cast<size_t>(index) != size_) {
+                    std::memcpy(new_data.GetAddress() + index + 1, data_.GetAddress() + index,
+                        (size_ - index) * sizeof(T));
+                }
+                data_.Swap(new_data);
+                return;
+            }
+        }
+
+        RawMemory<T, Allocator> new_data(new_capacity);
+        if (!std::is_constant_evaluated() && data_.Capacity() != 0) {
+            vector_stats::OnReallocation(size_ * sizeof(T));
+        }
         T* new_elem_pos = new_data.GetAddress() + index;
 
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // элемент конструируется первым: args могут ссылаться на элементы вектора,
+            // а сам перенос halves гарантированно не бросает — строгая гарантия бесплатно
+            std::construct_at(new_elem_pos, std::forward<Args>(args)...);
+            vector_detail::RelocateN(data_.GetAddress(), static_cast<size_t>(index), new_data.GetAddress());
+            vector_detail::RelocateN(data_.GetAddress() + index, size_ - index, new_elem_pos + 1);
+            data_.Swap(new_data);
+            return;
+        }
+
         // перемещение элементов перед позицией вставки
         if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), index, new_data.GetAddress());
+            vector_detail::MoveConstructN(data_.GetAddress(), static_cast<size_t>(index), new_data.GetAddress());
+        }
+        else if constexpr (Safety == ExceptionSafety::Fast) {
+            vector_detail::CopyConstructN(data_.GetAddress(), static_cast<size_t>(index), new_data.GetAddress());
         }
         else {
             try {
-                std::uninitialized_copy_n(data_.GetAddress(), index, new_data.GetAddress());
+                vector_detail::CopyConstructN(data_.GetAddress(), static_cast<size_t>(index), new_data.GetAddress());
             }
             catch (...) {
                 std::destroy_n(new_data.GetAddress(), index);
@@ -312,15 +1593,18 @@ private:
         }
 
         // создаём новый элемент на нужной позиции
-        new (new_elem_pos) T(std::forward<Args>(args)...);
+        std::construct_at(new_elem_pos, std::forward<Args>(args)...);
 
         // перемещение элементов после позиции вставки
         if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress() + index, size_ - index, new_elem_pos + 1);
+            vector_detail::MoveConstructN(data_.GetAddress() + index, size_ - index, new_elem_pos + 1);
+        }
+        else if constexpr (Safety == ExceptionSafety::Fast) {
+            vector_detail::CopyConstructN(data_.GetAddress() + index, size_ - index, new_elem_pos + 1);
         }
         else {
             try {
-                std::uninitialized_copy_n(data_.GetAddress() + index, size_ - index, new_elem_pos + 1);
+                vector_detail::CopyConstructN(data_.GetAddress() + index, size_ - index, new_elem_pos + 1);
             }
             catch (...) {
                 std::destroy_n(new_elem_pos, 1);
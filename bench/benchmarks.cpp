@@ -0,0 +1,275 @@
+// Сравнительные замеры Vector против std::vector.
+//
+// Сборка и запуск:
+//   g++ -std=c++20 -O2 -DNDEBUG -I../advanced-vector benchmarks.cpp -o benchmarks && ./benchmarks
+//
+// Необязательный аргумент — множитель размера задач (по умолчанию 1):
+//   ./benchmarks 10
+//
+// Замеряются PushBack/EmplaceBack, Insert в начало и середину, Erase,
+// Reserve, Resize и копирующее/перемещающее присваивание для трёх категорий
+// типов: тривиально копируемых, move-only и типов с бросающим копированием.
+
+#include "vector.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    // Тривиально копируемая запись — типичный «тик»
+    struct Tick {
+        uint64_t id;
+        double price;
+    };
+    static_assert(std::is_trivially_copyable_v<Tick>);
+
+    // Move-only тип: копирующие операции недоступны
+    struct MoveOnly {
+        std::unique_ptr<uint64_t> value;
+    };
+    static_assert(!std::is_copy_constructible_v<MoveOnly>);
+
+    // Тип с бросающим копированием и небросающим, но не помеченным noexcept перемещением:
+    // реаллокация обязана идти по копирующей ветке ради строгой гарантии
+    struct ThrowingCopy {
+        ThrowingCopy() = default;
+        explicit ThrowingCopy(std::string text)
+            : text(std::move(text)) {
+        }
+        ThrowingCopy(const ThrowingCopy& other) = default;
+        ThrowingCopy(ThrowingCopy&& other)
+            : text(std::move(other.text)) {
+        }
+        ThrowingCopy& operator=(const ThrowingCopy&) = default;
+        ThrowingCopy& operator=(ThrowingCopy&&) = default;
+        std::string text;
+    };
+    static_assert(!std::is_nothrow_move_constructible_v<ThrowingCopy>);
+
+    template <typename T>
+    T MakeValue(size_t i) {
+        if constexpr (std::is_same_v<T, Tick>) {
+            return Tick{ i, static_cast<double>(i) * 0.25 };
+        }
+        else if constexpr (std::is_same_v<T, MoveOnly>) {
+            return MoveOnly{ std::make_unique<uint64_t>(i) };
+        }
+        else {
+            return ThrowingCopy{ std::to_string(i) };
+        }
+    }
+
+    // Адаптеры, скрывающие разницу имён методов Vector и std::vector
+
+    template <typename C, typename V>
+    void DoPushBack(C& c, V&& value) {
+        if constexpr (requires { c.PushBack(std::forward<V>(value)); }) {
+            c.PushBack(std::forward<V>(value));
+        }
+        else {
+            c.push_back(std::forward<V>(value));
+        }
+    }
+
+    template <typename C, typename... Args>
+    void DoEmplaceBack(C& c, Args&&... args) {
+        if constexpr (requires { c.EmplaceBack(std::forward<Args>(args)...); }) {
+            c.EmplaceBack(std::forward<Args>(args)...);
+        }
+        else {
+            c.emplace_back(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename C, typename V>
+    void DoInsert(C& c, size_t index, V&& value) {
+        if constexpr (requires { c.Insert(c.begin(), std::forward<V>(value)); }) {
+            c.Insert(c.begin() + index, std::forward<V>(value));
+        }
+        else {
+            c.insert(c.begin() + index, std::forward<V>(value));
+        }
+    }
+
+    template <typename C>
+    void DoErase(C& c, size_t index) {
+        if constexpr (requires { c.Erase(c.begin()); }) {
+            c.Erase(c.begin() + index);
+        }
+        else {
+            c.erase(c.begin() + index);
+        }
+    }
+
+    template <typename C>
+    void DoReserve(C& c, size_t n) {
+        if constexpr (requires { c.Reserve(n); }) {
+            c.Reserve(n);
+        }
+        else {
+            c.reserve(n);
+        }
+    }
+
+    template <typename C>
+    void DoResize(C& c, size_t n) {
+        if constexpr (requires { c.Resize(n); }) {
+            c.Resize(n);
+        }
+        else {
+            c.resize(n);
+        }
+    }
+
+    template <typename C>
+    size_t DoSize(const C& c) {
+        if constexpr (requires { c.Size(); }) {
+            return c.Size();
+        }
+        else {
+            return c.size();
+        }
+    }
+
+    // Лучшее из kRepeats прогонов, наносекунды на операцию
+    template <typename Fn>
+    double MeasureNsPerOp(size_t ops, Fn fn) {
+        constexpr int kRepeats = 3;
+        double best = 1e30;
+        for (int r = 0; r < kRepeats; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto finish = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(finish - start).count();
+            best = std::min(best, ns / static_cast<double>(ops));
+        }
+        return best;
+    }
+
+    void Report(const char* type_name, const char* op_name, double ours_ns, double std_ns) {
+        std::printf("%-14s %-18s %10.2f %10.2f %8.2fx\n",
+            type_name, op_name, ours_ns, std_ns, std_ns / ours_ns);
+    }
+
+    template <typename C, typename T>
+    void FillContainer(C& c, size_t n) {
+        DoReserve(c, n);
+        for (size_t i = 0; i < n; ++i) {
+            DoPushBack(c, MakeValue<T>(i));
+        }
+    }
+
+    template <typename T>
+    void RunBenchmarks(const char* type_name, size_t scale) {
+        const size_t append_n = 200'000 * scale;
+        const size_t insert_n = 4'000 * scale;
+
+        const auto bench_pair = [&](const char* op_name, auto&& run) {
+            const double ours = run(static_cast<Vector<T>*>(nullptr));
+            const double theirs = run(static_cast<std::vector<T>*>(nullptr));
+            Report(type_name, op_name, ours, theirs);
+        };
+
+        bench_pair("PushBack", [&]<typename C>(C*) {
+            return MeasureNsPerOp(append_n, [&] {
+                C c;
+                for (size_t i = 0; i < append_n; ++i) {
+                    DoPushBack(c, MakeValue<T>(i));
+                }
+            });
+        });
+
+        bench_pair("EmplaceBack", [&]<typename C>(C*) {
+            return MeasureNsPerOp(append_n, [&] {
+                C c;
+                for (size_t i = 0; i < append_n; ++i) {
+                    DoEmplaceBack(c, MakeValue<T>(i));
+                }
+            });
+        });
+
+        bench_pair("InsertFront", [&]<typename C>(C*) {
+            return MeasureNsPerOp(insert_n, [&] {
+                C c;
+                for (size_t i = 0; i < insert_n; ++i) {
+                    DoInsert(c, 0, MakeValue<T>(i));
+                }
+            });
+        });
+
+        bench_pair("InsertMiddle", [&]<typename C>(C*) {
+            return MeasureNsPerOp(insert_n, [&] {
+                C c;
+                for (size_t i = 0; i < insert_n; ++i) {
+                    DoInsert(c, DoSize(c) / 2, MakeValue<T>(i));
+                }
+            });
+        });
+
+        bench_pair("EraseFront", [&]<typename C>(C*) {
+            return MeasureNsPerOp(insert_n, [&] {
+                C c;
+                FillContainer<C, T>(c, insert_n);
+                for (size_t i = 0; i < insert_n; ++i) {
+                    DoErase(c, 0);
+                }
+            });
+        });
+
+        bench_pair("Reserve", [&]<typename C>(C*) {
+            return MeasureNsPerOp(append_n, [&] {
+                C c;
+                FillContainer<C, T>(c, append_n / 2);
+                DoReserve(c, append_n);       // реаллокация с переносом элементов
+                DoReserve(c, append_n * 2);   // и ещё одна
+            });
+        });
+
+        bench_pair("Resize", [&]<typename C>(C*) {
+            return MeasureNsPerOp(append_n, [&] {
+                C c;
+                DoResize(c, append_n);
+                DoResize(c, append_n / 2);
+                DoResize(c, append_n * 2);
+            });
+        });
+
+        bench_pair("MoveAssign", [&]<typename C>(C*) {
+            return MeasureNsPerOp(append_n, [&] {
+                C src;
+                FillContainer<C, T>(src, append_n);
+                C dst;
+                dst = std::move(src);
+            });
+        });
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            bench_pair("CopyAssign", [&]<typename C>(C*) {
+                return MeasureNsPerOp(append_n, [&] {
+                    C src;
+                    FillContainer<C, T>(src, append_n);
+                    C dst;
+                    dst = src;
+                });
+            });
+        }
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t scale = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1;
+
+    std::printf("%-14s %-18s %10s %10s %9s\n",
+        "type", "operation", "Vector,ns", "std,ns", "speedup");
+
+    RunBenchmarks<Tick>("trivial", scale);
+    RunBenchmarks<MoveOnly>("move-only", scale);
+    RunBenchmarks<ThrowingCopy>("throwing-copy", scale);
+}
@@ -0,0 +1,308 @@
+// Стресс-прогон и ворота производительности Vector.
+//
+// Сборка и запуск:
+//   g++ -std=c++20 -O2 -DNDEBUG -I../advanced-vector stress.cpp -o stress && ./stress
+//
+// Гоняет случайные миксы операций (append-heavy, insert-heavy, erase-heavy,
+// смешанный) на миллионных объёмах и для каждого сценария записывает
+// стену времени, число выделений, число реаллокаций и объём перенесённых
+// байтов (через ADVANCED_VECTOR_STATS), плюс пиковый RSS процесса.
+// Результаты сравниваются с сохранённым базовым замером; при деградации
+// сверх порога процесс завершается с ненулевым кодом — это ворота перед
+// выкаткой любых оптимизаций контейнера.
+//
+// Использование:
+//   ./stress [множитель масштаба] [--update-baseline] [--baseline путь]
+//
+// Первый запуск на новой машине: ./stress --update-baseline — базовый замер
+// привязан к железу и в репозитории не хранится.
+
+#define ADVANCED_VECTOR_STATS
+
+#include "vector.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+
+namespace {
+
+    // Запись фиксированного размера — типичная нагрузка торговых журналов
+    struct Record {
+        uint64_t id;
+        uint64_t payload[3];
+    };
+    static_assert(std::is_trivially_copyable_v<Record>);
+
+    // Порог деградации: стена времени шумит сильнее счётчиков
+    constexpr double kWallTimeTolerance = 1.35;
+    constexpr double kCounterTolerance = 1.10;
+    // Абсолютный зазор для коротких сценариев, где миллисекунда — уже проценты
+    constexpr double kWallTimeSlackMs = 5.0;
+
+    struct RunResult {
+        double wall_ms = 0.0;
+        uint64_t allocations = 0;
+        uint64_t reallocations = 0;
+        uint64_t bytes_relocated = 0;
+    };
+
+    using Results = std::map<std::string, RunResult>;
+
+    uint64_t ReadPeakRssKb() {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::strtoull(line.c_str() + 6, nullptr, 10);
+            }
+        }
+#endif
+        return 0;
+    }
+
+    // Прогоняет сценарий с обнулёнными счётчиками и снимает метрики
+    template <typename Scenario>
+    RunResult Measure(Scenario scenario) {
+        vector_stats::Get().Reset();
+        const auto start = std::chrono::steady_clock::now();
+        scenario();
+        const auto finish = std::chrono::steady_clock::now();
+        RunResult result;
+        result.wall_ms = std::chrono::duration<double, std::milli>(finish - start).count();
+        result.allocations = vector_stats::Get().allocations.load();
+        result.reallocations = vector_stats::Get().reallocation_events.load();
+        result.bytes_relocated = vector_stats::Get().bytes_relocated.load();
+        return result;
+    }
+
+    // Контрольная сумма не даёт компилятору выбросить работу сценариев
+    uint64_t g_checksum = 0;
+
+    uint64_t Consume(const Vector<Record>& v) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < v.Size(); i += 97) {
+            sum += v[i].id;
+        }
+        return sum;
+    }
+
+    // Append-heavy: чистый рост через PushBack — греет Reserve и политику роста
+    void RunAppendHeavy(size_t scale) {
+        const size_t n = 4'000'000 * scale;
+        Vector<Record> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.PushBack(Record{ i, { i, i * 2, i * 3 } });
+        }
+        g_checksum += Consume(v);
+    }
+
+    // Insert-heavy: вставки в случайные позиции — сдвиги хвоста и реаллокации
+    void RunInsertHeavy(size_t scale) {
+        const size_t n = 40'000 * scale;
+        std::mt19937_64 rng(12345);
+        Vector<Record> v;
+        for (size_t i = 0; i < n; ++i) {
+            const size_t pos = v.Size() == 0 ? 0 : rng() % (v.Size() + 1);
+            v.Insert(v.begin() + pos, Record{ i, { i, i, i } });
+        }
+        g_checksum += Consume(v);
+    }
+
+    // Erase-heavy: поштучные удаления из случайных позиций плюс пакетный EraseIf.
+    // Объём меньше остальных сценариев: каждое поштучное удаление — O(n)
+    void RunEraseHeavy(size_t scale) {
+        const size_t n = 100'000 * scale;
+        std::mt19937_64 rng(67890);
+        Vector<Record> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.PushBack(Record{ i, { i, i, i } });
+        }
+        for (size_t i = 0; i < n / 8; ++i) {
+            v.Erase(v.begin() + rng() % v.Size());
+        }
+        v.EraseIf([](const Record& r) {
+            return r.id % 3 == 0;
+        });
+        g_checksum += Consume(v);
+    }
+
+    // Смешанный микс, приближённый к боевому: рост с вкраплениями вставок,
+    // удалений и изменений размера
+    void RunMixed(size_t scale) {
+        const size_t ops = 1'000'000 * scale;
+        std::mt19937_64 rng(424242);
+        Vector<Record> v;
+        for (size_t i = 0; i < ops; ++i) {
+            const uint64_t dice = rng() % 100;
+            if (dice < 70 || v.Size() == 0) {
+                v.PushBack(Record{ i, { i, i, i } });
+            }
+            else if (dice < 80) {
+                v.PopBack();
+            }
+            else if (dice < 85) {
+                // точечные правки — у хвоста, как в боевых журналах
+                const size_t window = std::min<size_t>(v.Size(), 1024);
+                v.Insert(v.end() - rng() % (window + 1), Record{ i, { i, i, i } });
+            }
+            else if (dice < 90) {
+                const size_t window = std::min<size_t>(v.Size(), 1024);
+                v.Erase(v.end() - 1 - rng() % window);
+            }
+            else if (dice < 95) {
+                v.Resize(v.Size() - std::min<size_t>(v.Size(), rng() % 8));
+            }
+            else {
+                v.Reserve(v.Size() + rng() % 1024);
+            }
+        }
+        g_checksum += Consume(v);
+    }
+
+    Results RunAll(size_t scale) {
+        Results results;
+        results["append"] = Measure([scale] { RunAppendHeavy(scale); });
+        results["insert"] = Measure([scale] { RunInsertHeavy(scale); });
+        results["erase"] = Measure([scale] { RunEraseHeavy(scale); });
+        results["mixed"] = Measure([scale] { RunMixed(scale); });
+        return results;
+    }
+
+    void Print(const Results& results) {
+        std::printf("%-8s %12s %14s %14s %16s\n",
+            "scenario", "wall_ms", "allocations", "reallocations", "bytes_relocated");
+        for (const auto& [name, r] : results) {
+            std::printf("%-8s %12.2f %14" PRIu64 " %14" PRIu64 " %16" PRIu64 "\n",
+                name.c_str(), r.wall_ms, r.allocations, r.reallocations, r.bytes_relocated);
+        }
+        std::printf("peak RSS: %" PRIu64 " kB\n", ReadPeakRssKb());
+    }
+
+    bool SaveBaseline(const Results& results, const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            std::fprintf(stderr, "не удалось записать базовый замер в %s\n", path.c_str());
+            return false;
+        }
+        for (const auto& [name, r] : results) {
+            out << name << ' ' << r.wall_ms << ' ' << r.allocations << ' '
+                << r.reallocations << ' ' << r.bytes_relocated << '\n';
+        }
+        out << "peak_rss_kb " << ReadPeakRssKb() << '\n';
+        return true;
+    }
+
+    bool LoadBaseline(Results& results, uint64_t& peak_rss_kb, const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            return false;
+        }
+        std::string name;
+        while (in >> name) {
+            if (name == "peak_rss_kb") {
+                in >> peak_rss_kb;
+                continue;
+            }
+            RunResult r;
+            in >> r.wall_ms >> r.allocations >> r.reallocations >> r.bytes_relocated;
+            results[name] = r;
+        }
+        return true;
+    }
+
+    bool CheckMetric(const char* scenario, const char* metric,
+        double current, double baseline, double tolerance, double slack) {
+        if (current <= baseline * tolerance + slack) {
+            return true;
+        }
+        std::fprintf(stderr, "РЕГРЕССИЯ: %s/%s: %.2f против базовых %.2f (порог x%.2f)\n",
+            scenario, metric, current, baseline, tolerance);
+        return false;
+    }
+
+    // Сравнивает прогон с базовым замером; возвращает false при регрессии
+    bool Compare(const Results& current, const Results& baseline, uint64_t baseline_rss_kb) {
+        bool ok = true;
+        for (const auto& [name, base] : baseline) {
+            const auto it = current.find(name);
+            if (it == current.end()) {
+                std::fprintf(stderr, "сценарий %s есть в базовом замере, но не был прогнан\n",
+                    name.c_str());
+                ok = false;
+                continue;
+            }
+            const RunResult& run = it->second;
+            ok &= CheckMetric(name.c_str(), "wall_ms",
+                run.wall_ms, base.wall_ms, kWallTimeTolerance, kWallTimeSlackMs);
+            ok &= CheckMetric(name.c_str(), "allocations",
+                static_cast<double>(run.allocations), static_cast<double>(base.allocations),
+                kCounterTolerance, 0.0);
+            ok &= CheckMetric(name.c_str(), "reallocations",
+                static_cast<double>(run.reallocations), static_cast<double>(base.reallocations),
+                kCounterTolerance, 0.0);
+            ok &= CheckMetric(name.c_str(), "bytes_relocated",
+                static_cast<double>(run.bytes_relocated), static_cast<double>(base.bytes_relocated),
+                kCounterTolerance, 0.0);
+        }
+        if (baseline_rss_kb != 0) {
+            ok &= CheckMetric("process", "peak_rss_kb",
+                static_cast<double>(ReadPeakRssKb()), static_cast<double>(baseline_rss_kb),
+                kCounterTolerance, 0.0);
+        }
+        return ok;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t scale = 1;
+    bool update_baseline = false;
+    std::string baseline_path = "stress_baseline.txt";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--update-baseline") == 0) {
+            update_baseline = true;
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        }
+        else {
+            scale = std::strtoull(argv[i], nullptr, 10);
+            if (scale == 0) {
+                scale = 1;
+            }
+        }
+    }
+
+    const Results results = RunAll(scale);
+    Print(results);
+    std::printf("checksum: %" PRIu64 "\n", g_checksum);
+
+    if (update_baseline) {
+        if (!SaveBaseline(results, baseline_path)) {
+            return 2;
+        }
+        std::printf("базовый замер сохранён в %s\n", baseline_path.c_str());
+        return 0;
+    }
+
+    Results baseline;
+    uint64_t baseline_rss_kb = 0;
+    if (!LoadBaseline(baseline, baseline_rss_kb, baseline_path)) {
+        std::printf("базовый замер %s не найден — запустите с --update-baseline\n",
+            baseline_path.c_str());
+        return 0;
+    }
+    if (!Compare(results, baseline, baseline_rss_kb)) {
+        return 1;
+    }
+    std::printf("регрессий нет\n");
+    return 0;
+}